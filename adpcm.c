@@ -0,0 +1,75 @@
+#include "adpcm.h"
+
+static const short kStep[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+static const signed char kIndexStep[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+typedef struct AdpcmState {
+    int predictor;
+    int index;
+} AdpcmState;
+
+// Apply one nibble to the state; encoder and decoder share this so they
+// never drift apart
+static inline int Step(AdpcmState* s, int nibble) {
+    int step = kStep[s->index];
+    int diff = step >> 3;
+    if (nibble & 1) diff += step >> 2;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 4) diff += step;
+    if (nibble & 8) diff = -diff;
+    int p = s->predictor + diff;
+    s->predictor = p < -32768 ? -32768 : p > 32767 ? 32767 : p;
+    int i = s->index + kIndexStep[nibble];
+    s->index = i < 0 ? 0 : i > 88 ? 88 : i;
+    return s->predictor;
+}
+
+static int Quantize(const AdpcmState* s, int sample) {
+    int step = kStep[s->index];
+    int diff = sample - s->predictor;
+    int nibble = 0;
+    if (diff < 0) { nibble = 8; diff = -diff; }
+    if (diff >= step) { nibble |= 4; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { nibble |= 2; diff -= step; }
+    step >>= 1;
+    if (diff >= step) nibble |= 1;
+    return nibble;
+}
+
+void Adpcm_Encode(unsigned char* out, const short* pcm, unsigned frames, unsigned channels) {
+    AdpcmState st[2] = { { 0, 0 }, { 0, 0 } };
+    unsigned n = frames * channels;
+    for (unsigned i = 0; i < n; i++) {
+        AdpcmState* s = &st[channels == 2 ? i & 1 : 0];
+        int nibble = Quantize(s, pcm[i]);
+        Step(s, nibble);
+        if (i & 1) out[i >> 1] |= (unsigned char)(nibble << 4);
+        else       out[i >> 1] = (unsigned char)nibble;
+    }
+}
+
+void Adpcm_Decode(short* out, const unsigned char* in, unsigned frames, unsigned channels) {
+    AdpcmState st[2] = { { 0, 0 }, { 0, 0 } };
+    unsigned n = frames * channels;
+    if (channels == 2) {
+        // stereo: each byte is one frame, left in the low nibble
+        for (unsigned f = 0; f < frames; f++) {
+            out[2 * f]     = (short)Step(&st[0], in[f] & 15);
+            out[2 * f + 1] = (short)Step(&st[1], in[f] >> 4);
+        }
+        return;
+    }
+    for (unsigned i = 0; i + 1 < n; i += 2) {
+        out[i]     = (short)Step(&st[0], in[i >> 1] & 15);
+        out[i + 1] = (short)Step(&st[0], in[i >> 1] >> 4);
+    }
+    if (n & 1) out[n - 1] = (short)Step(&st[0], in[n >> 1] & 15);
+}
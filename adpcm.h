@@ -0,0 +1,26 @@
+#ifndef ADPCM_H
+#define ADPCM_H
+#include <stddef.h>
+#pragma once
+
+// IMA ADPCM: 4 bits per sample, a quarter of 16-bit PCM. Decoding is a table
+// lookup and a few adds per sample, cheap enough to do when a sound is about
+// to play. Samples are interleaved like the PCM they came from; sample n is
+// the low (even n) or high (odd n) nibble of byte n/2, and every channel
+// starts from silence with the smallest step.
+typedef struct AdpcmSound {
+    unsigned char* data;        // NULL when empty; owned (MemAlloc)
+    unsigned       size;        // bytes, (frames * channels + 1) / 2
+    unsigned       frames;
+    unsigned       sampleRate;
+    unsigned       channels;    // 1 or 2
+    float          volume;      // applied when the PCM is made
+} AdpcmSound;
+
+#define ADPCM_BYTES(frames, channels) (((frames) * (channels) + 1) / 2)
+
+// pcm holds frames * channels interleaved 16-bit samples
+void Adpcm_Encode(unsigned char* out, const short* pcm, unsigned frames, unsigned channels);
+void Adpcm_Decode(short* out, const unsigned char* in, unsigned frames, unsigned channels);
+
+#endif
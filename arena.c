@@ -0,0 +1,73 @@
+#include "arena.h"
+#include "raylib.h"
+#include <string.h>
+
+struct ArenaBlock {
+    ArenaBlock* next;
+    size_t      size;
+    size_t      used;
+    // payload follows (header padded to 16 bytes below)
+};
+
+#define ARENA_ALIGN 16
+#define ARENA_HEADER ((sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+static unsigned char* BlockData(ArenaBlock* b) { return (unsigned char*)b + ARENA_HEADER; }
+
+void Arena_Init(Arena* a, size_t blockSize) {
+    *a = (Arena){ 0 };
+    a->blockSize = blockSize ? blockSize : 64 * 1024;
+}
+
+static ArenaBlock* NewBlock(Arena* a, size_t minSize) {
+    // reuse a spare block if it is large enough
+    for (ArenaBlock** link = &a->spare; *link; link = &(*link)->next) {
+        if ((*link)->size >= minSize) {
+            ArenaBlock* b = *link;
+            *link = b->next;
+            b->used = 0;
+            return b;
+        }
+    }
+    size_t size = (minSize > a->blockSize) ? minSize : a->blockSize;
+    ArenaBlock* b = MemAlloc((unsigned int)(ARENA_HEADER + size));
+    if (!b) return NULL;
+    b->size = size;
+    b->used = 0;
+    a->reserved += size;
+    return b;
+}
+
+void* Arena_Alloc(Arena* a, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    ArenaBlock* b = a->head;
+    if (!b || b->used + size > b->size) {
+        b = NewBlock(a, size);
+        if (!b) return NULL;
+        b->next = a->head;
+        a->head = b;
+    }
+    void* p = BlockData(b) + b->used;
+    b->used += size;
+    memset(p, 0, size);
+    return p;
+}
+
+void Arena_Reset(Arena* a) {
+    while (a->head) {
+        ArenaBlock* b = a->head;
+        a->head = b->next;
+        b->next = a->spare;
+        a->spare = b;
+    }
+}
+
+void Arena_Free(Arena* a) {
+    Arena_Reset(a);
+    while (a->spare) {
+        ArenaBlock* b = a->spare;
+        a->spare = b->next;
+        MemFree(b);
+    }
+    a->reserved = 0;
+}
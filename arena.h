@@ -0,0 +1,22 @@
+#ifndef ARENA_H
+#define ARENA_H
+#include <stddef.h>
+#pragma once
+
+// Bump allocator over a chain of fixed-size blocks. Allocations never move,
+// so pointers into the arena stay valid until Arena_Reset/Arena_Free.
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct Arena {
+    ArenaBlock* head;       // current block (older blocks chained behind it)
+    ArenaBlock* spare;      // blocks kept around by Arena_Reset
+    size_t      blockSize;  // default block payload size
+    size_t      reserved;   // total bytes held, for stats
+} Arena;
+
+void  Arena_Init(Arena* a, size_t blockSize);
+void* Arena_Alloc(Arena* a, size_t size);   // zeroed, 16-byte aligned
+void  Arena_Reset(Arena* a);                // drop all allocations, keep memory
+void  Arena_Free(Arena* a);                 // release everything
+
+#endif
@@ -1,40 +1,56 @@
 #include "assets.h"
 #include "raylib.h"
 #include "raymath.h"
-#include <math.h>   // sinf, PI
-#include <stdio.h>  // snprintf
-
-// Load a sprite with guaranteed RGBA, premultiplied alpha, and crisp filtering
-static Texture2D LoadSprite(const char* path) {
-    Image img = LoadImage(path);
-    if (!img.data) { TraceLog(LOG_ERROR, "FAILED to load %s", path); return (Texture2D) { 0 }; }
-
-    // Ensure RGBA
-    if (img.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
-        ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
-
-    // Premultiply to avoid white/black fringes on transparency
-    ImageAlphaPremultiply(&img);
-
-    Texture2D tex = LoadTextureFromImage(img);
-    UnloadImage(img);
-
-    // Pixel art friendly (no blurry halos) + no tiling seams
-    SetTextureFilter(tex, TEXTURE_FILTER_POINT);
-    SetTextureWrap(tex, TEXTURE_WRAP_CLAMP);
-
-    TraceLog(LOG_INFO, "Loaded %s (%dx%d)", path, tex.width, tex.height);
-    return tex;
-}
-
-
-static void Pix(Texture2D* t) {
-    if (t && t->id) SetTextureFilter(*t, TEXTURE_FILTER_POINT); 
-}
-
-static Texture2D LoadIfExists(const char* path) {
-    if (FileExists(path)) return LoadTexture(path);
-    return (Texture2D) { 0 }; // width==0 means missing
+#include "profile.h"
+#include "mapfile.h"
+#include "timer.h"
+#include "thread.h"
+#include <math.h>     // sinf, PI
+#include <stddef.h>   // offsetof
+#include <stdio.h>    // snprintf
+#include <string.h>
+
+// Every sprite and sound in a fixed order; the bundle stores them by index
+static const size_t kSpriteFields[] = {
+    offsetof(Assets, sprPlayerRight), offsetof(Assets, sprPlayerLeft),
+    offsetof(Assets, sprPlayerUp),    offsetof(Assets, sprPlayerDown),
+    offsetof(Assets, sprRival), offsetof(Assets, sprBerry), offsetof(Assets, sprStick),
+    offsetof(Assets, sprPond),  offsetof(Assets, sprClue),  offsetof(Assets, sprGrass),
+    offsetof(Assets, uiHeart),  offsetof(Assets, uiFood),   offsetof(Assets, uiWater),
+    offsetof(Assets, white),
+};
+static const size_t kSoundFields[] = {
+    offsetof(Assets, sPickupFood), offsetof(Assets, sPickupStick), offsetof(Assets, sDrink),
+    offsetof(Assets, sClue),       offsetof(Assets, sCraft),
+};
+static const float kSoundVolume[] = { 0.55f, 0.55f, 0.60f, 0.65f, 0.70f };
+
+#define SPRITE_COUNT ((int)(sizeof(kSpriteFields) / sizeof(kSpriteFields[0])))
+#define SOUND_COUNT  ((int)(sizeof(kSoundFields) / sizeof(kSoundFields[0])))
+
+static Sprite* SpriteAt(Assets* a, int i) { return (Sprite*)((char*)a + kSpriteFields[i]); }
+static AdpcmSound* SoundAt(Assets* a, int i) { return (AdpcmSound*)((char*)a + kSoundFields[i]); }
+
+// Everything Assets_Load needs, already decoded and packed: atlas pages as
+// RGBA8 images, each sprite's page and rectangle, and SFX as IMA ADPCM.
+// Built from loose files (and placeholders) by DecodeSources, or pointing
+// straight into a mapped bundle.
+typedef struct AssetSources {
+    Image     pages[ATLAS_MAX_PAGES];
+    int       pageCount;
+    int       spritePage[SPRITE_COUNT];
+    Rectangle spriteRect[SPRITE_COUNT];
+    AdpcmSound sounds[SOUND_COUNT];
+} AssetSources;
+
+static Image LoadImageIfExists(const char* path) {
+    if (FileExists(path)) {
+        Image img = LoadImage(path);
+        if (img.data && img.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+            ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        return img;
+    }
+    return (Image) { 0 }; // width==0 means missing
 }
 
 static Image GenMoodyGrassTile(int s) {
@@ -59,14 +75,13 @@ static Image GenCircleImage(int size, Color fill, Color bg) {
     return img;
 }
 
-static Sound LoadSndIfExists(const char* path) {
-    if (FileExists(path)) return LoadSound(path);
-    Sound s = (Sound){ 0 };
-    return s;
+static Wave LoadWaveIfExists(const char* path) {
+    if (FileExists(path)) return LoadWave(path);
+    return (Wave) { 0 };
 }
 
-// Generate short mono 16-bit sine beep and return as Sound
-static Sound GenBeep(float freq, float seconds, float volume) {
+// Short mono 16-bit sine beep
+static Wave GenBeep(float freq, float seconds, float volume) {
     const int sampleRate = 44100;
     const int channels = 1;
     const int frames = (int)(seconds * sampleRate);
@@ -78,10 +93,7 @@ static Sound GenBeep(float freq, float seconds, float volume) {
         if (v > 1.0f) v = 1.0f; if (v < -1.0f) v = -1.0f;
         pcm[i] = (short)(v * 32767.0f);
     }
-    Wave w = { (unsigned)frames, 44100, 16, 1, pcm };
-    Sound s = LoadSoundFromWave(w);
-    UnloadWave(w); // frees pcm
-    return s;
+    return (Wave) { (unsigned)frames, 44100, 16, 1, pcm };
 }
 
 // Try assets/<name>.ogg/.mp3/.wav in that order
@@ -103,122 +115,513 @@ static Image GenPond(int size) {
     return img;
 }
 
-void Assets_Load(Assets* a) {
+// -----------------------------------------------------------------------------
+// Atlas packing: shelf packer over the sprite images, tallest first. Every
+// sprite gets a 1px border copied from its own edge pixels, so point sampling
+// at fractional zoom never picks up a neighbour.
+#define ATLAS_PAD 1
+#define ATLAS_MIN_SIZE 256
+#define ATLAS_MAX_SIZE 2048
+
+typedef struct AtlasItem {
+    Image img;
+    int   id;      // index into kSpriteFields
+} AtlasItem;
+
+static void CopyExtruded(Image* page, const Image* img, int dx, int dy) {
+    Color* dst = (Color*)page->data;
+    const Color* src = (const Color*)img->data;
+    for (int y = -ATLAS_PAD; y < img->height + ATLAS_PAD; y++) {
+        int sy = (y < 0) ? 0 : (y >= img->height) ? img->height - 1 : y;
+        for (int x = -ATLAS_PAD; x < img->width + ATLAS_PAD; x++) {
+            int sx = (x < 0) ? 0 : (x >= img->width) ? img->width - 1 : x;
+            dst[(dy + y) * page->width + (dx + x)] = src[sy * img->width + sx];
+        }
+    }
+}
 
-    // Try to load from disk
-    a->texPlayerRight = LoadTexture("assets/player_right.png");
-    a->texPlayerLeft = LoadTexture("assets/player_left.png");
-    a->texPlayerUp = LoadTexture("assets/player_up.png");
-    a->texPlayerDown = LoadTexture("assets/player_down.png");
-    a->texRival = LoadIfExists("assets/rival.png");
-    a->texBerry = LoadIfExists("assets/berry.png");
-    a->texStick = LoadIfExists("assets/stick.png");
-    a->texPond = LoadIfExists("assets/pond.png");
-    a->texClue = LoadIfExists("assets/clue.png");
-    a->uiHeart = LoadIfExists("assets/ui_heart.png");
-    a->uiFood = LoadIfExists("assets/ui_food.png");
-    a->uiWater = LoadIfExists("assets/ui_water.png");
-
-
-    // Generate placeholders where missing
-    // --- Generate placeholders for missing player direction sprites ---
-    if (a->texPlayerRight.width == 0) {
-        Image i = GenCircleImage(24, (Color) { 255, 255, 255, 255 }, (Color) { 0, 0, 0, 0 });
-        ImageDrawRectangle(&i, 12, 8, 10, 8, (Color) { 120, 180, 255, 255 });
-        a->texPlayerRight = LoadTextureFromImage(i);
-        UnloadImage(i);
-    }
-
-    if (a->texPlayerLeft.width == 0) {
-        Image i = GenCircleImage(24, (Color) { 255, 255, 255, 255 }, (Color) { 0, 0, 0, 0 });
-        ImageDrawRectangle(&i, 2, 8, 10, 8, (Color) { 120, 180, 255, 255 });
-        a->texPlayerLeft = LoadTextureFromImage(i);
-        UnloadImage(i);
-    }
-
-    if (a->texPlayerUp.width == 0) {
-        Image i = GenCircleImage(24, (Color) { 255, 255, 255, 255 }, (Color) { 0, 0, 0, 0 });
-        ImageDrawRectangle(&i, 7, 2, 10, 8, (Color) { 120, 180, 255, 255 });
-        a->texPlayerUp = LoadTextureFromImage(i);
-        UnloadImage(i);
-    }
-
-    if (a->texPlayerDown.width == 0) {
-        Image i = GenCircleImage(24, (Color) { 255, 255, 255, 255 }, (Color) { 0, 0, 0, 0 });
-        ImageDrawRectangle(&i, 7, 12, 10, 8, (Color) { 120, 180, 255, 255 });
-        a->texPlayerDown = LoadTextureFromImage(i);
-        UnloadImage(i);
-    }
-    if (a->texRival.width == 0) { Image i = GenCircleImage(26, (Color) { 200, 60, 60, 255 }, (Color) { 0, 0, 0, 0 }); a->texRival = LoadTextureFromImage(i); UnloadImage(i); }
-    if (a->texBerry.width == 0) { Image i = GenCircleImage(20, (Color) { 180, 40, 60, 255 }, (Color) { 0, 0, 0, 0 }); a->texBerry = LoadTextureFromImage(i); UnloadImage(i); }
-    if (a->texStick.width == 0) { Image i = GenImageColor(18, 18, (Color) { 0, 0, 0, 0 }); ImageDrawRectangle(&i, 7, 2, 4, 14, (Color) { 120, 80, 60, 255 }); a->texStick = LoadTextureFromImage(i); UnloadImage(i); }
-    if (a->texPond.width == 0) { Image i = GenPond(56); a->texPond = LoadTextureFromImage(i); UnloadImage(i); }
-    if (a->texClue.width == 0) { Image i = GenCircleImage(22, (Color) { 230, 230, 40, 230 }, (Color) { 0, 0, 0, 0 }); a->texClue = LoadTextureFromImage(i); UnloadImage(i); }
-    if (a->uiHeart.width == 0) { Image i = GenImageColor(20, 20, (Color) { 0, 0, 0, 0 }); ImageDrawRectangle(&i, 4, 6, 12, 10, RED); a->uiHeart = LoadTextureFromImage(i); UnloadImage(i); }
-    if (a->uiFood.width == 0) { Image i = GenImageColor(20, 20, (Color) { 0, 0, 0, 0 }); ImageDrawRectangle(&i, 6, 6, 8, 8, (Color) { 200, 120, 50, 255 }); a->uiFood = LoadTextureFromImage(i); UnloadImage(i); }
-    if (a->uiWater.width == 0) { Image i = GenImageColor(20, 20, (Color) { 0, 0, 0, 0 }); ImageDrawCircle(&i, 10, 10, 7, (Color) { 50, 140, 220, 255 }); a->uiWater = LoadTextureFromImage(i); UnloadImage(i); }
-   
-    Pix(&a->texPlayerRight);
-    Pix(&a->texPlayerLeft);
-    Pix(&a->texPlayerUp);
-    Pix(&a->texPlayerDown);
-    Pix(&a->texRival);
-    Pix(&a->texBerry);
-    Pix(&a->texStick);
-    Pix(&a->texPond);
-    Pix(&a->texClue);   
-    Pix(&a->uiHeart);
-    Pix(&a->uiFood);
-    Pix(&a->uiWater);
-
-
-    // ---------- SFX ----------
-    a->sPickupFood = LoadSndIfExists("assets/pickup_food.wav");
-    a->sPickupStick = LoadSndIfExists("assets/pickup_stick.wav");
-    a->sDrink = LoadSndIfExists("assets/drink.wav");
-    a->sClue = LoadSndIfExists("assets/clue.wav");
-    a->sCraft = LoadSndIfExists("assets/craft.wav");
-
-    // Fallback beeps if files are missing
-    if (a->sPickupFood.frameCount == 0) a->sPickupFood = GenBeep(880.0f, 0.07f, 0.45f);
-    if (a->sPickupStick.frameCount == 0) a->sPickupStick = GenBeep(660.0f, 0.07f, 0.45f);
-    if (a->sDrink.frameCount == 0) a->sDrink = GenBeep(520.0f, 0.10f, 0.40f);
-    if (a->sClue.frameCount == 0) a->sClue = GenBeep(980.0f, 0.09f, 0.50f);
-    if (a->sCraft.frameCount == 0) a->sCraft = GenBeep(180.0f, 0.10f, 0.55f); // low thunk
-
-    SetSoundVolume(a->sPickupFood, 0.55f);
-    SetSoundVolume(a->sPickupStick, 0.55f);
-    SetSoundVolume(a->sDrink, 0.60f);
-    SetSoundVolume(a->sClue, 0.65f);
-    SetSoundVolume(a->sCraft, 0.70f);
-
-    // ---------- Background music ----------
-    a->bgDay = LoadMusicIfExists("bg_day");   // assets/bg_day.(ogg|mp3|wav)
-    a->bgNight = LoadMusicIfExists("bg_night"); // assets/bg_night.(ogg|mp3|wav)
-    if (a->bgDay.ctxData) { a->bgDay.looping = true; SetMusicVolume(a->bgDay, 0.0f); }
-    if (a->bgNight.ctxData) { a->bgNight.looping = true; SetMusicVolume(a->bgNight, 0.0f); }
+// Place items[first..] on a size x size shelf layout; returns how many fit.
+// Positions are written to xs/ys.
+static int ShelfPlace(const AtlasItem* items, int first, int count, int size, int* xs, int* ys) {
+    int x = 0, y = 0, shelf = 0;
+    int placed = 0;
+    for (int i = first; i < count; i++) {
+        int w = items[i].img.width + 2 * ATLAS_PAD, h = items[i].img.height + 2 * ATLAS_PAD;
+        if (x + w > size) { x = 0; y += shelf; shelf = 0; }
+        if (w > size || y + h > size) break;
+        xs[i] = x + ATLAS_PAD;
+        ys[i] = y + ATLAS_PAD;
+        x += w;
+        if (h > shelf) shelf = h;
+        placed++;
+    }
+    return placed;
+}
 
+static void BuildAtlas(AssetSources* src, AtlasItem* items, int count) {
+    // tallest first keeps shelves tight
+    for (int i = 1; i < count; i++) {
+        AtlasItem it = items[i];
+        int j = i - 1;
+        while (j >= 0 && items[j].img.height < it.img.height) { items[j + 1] = items[j]; j--; }
+        items[j + 1] = it;
+    }
+
+    int xs[SPRITE_COUNT], ys[SPRITE_COUNT];   // items is the sprite table, so count <= SPRITE_COUNT
+    int first = 0;
+    src->pageCount = 0;
+    while (first < count && src->pageCount < ATLAS_MAX_PAGES) {
+        // smallest power-of-two page that takes everything left, else a full-size page
+        int size = ATLAS_MIN_SIZE, placed = 0;
+        for (; size <= ATLAS_MAX_SIZE; size *= 2) {
+            placed = ShelfPlace(items, first, count, size, xs, ys);
+            if (first + placed == count) break;
+        }
+        if (size > ATLAS_MAX_SIZE) size = ATLAS_MAX_SIZE;
+        if (placed == 0) { TraceLog(LOG_ERROR, "ATLAS: sprite %dx%d does not fit", items[first].img.width, items[first].img.height); break; }
+
+        Image page = GenImageColor(size, size, (Color) { 0, 0, 0, 0 });
+        for (int i = first; i < first + placed; i++) {
+            CopyExtruded(&page, &items[i].img, xs[i], ys[i]);
+            src->spritePage[items[i].id] = src->pageCount;
+            src->spriteRect[items[i].id] = (Rectangle){ (float)xs[i], (float)ys[i], (float)items[i].img.width, (float)items[i].img.height };
+        }
+        src->pages[src->pageCount++] = page;
+        TraceLog(LOG_INFO, "ATLAS: page %d is %dx%d with %d sprites", src->pageCount - 1, size, size, placed);
+        first += placed;
+    }
+}
+
+static Image GenPlayerImage(int visorX, int visorY) {
+    Image i = GenCircleImage(24, (Color) { 255, 255, 255, 255 }, (Color) { 0, 0, 0, 0 });
+    ImageDrawRectangle(&i, visorX, visorY, 10, 8, (Color) { 120, 180, 255, 255 });
+    return i;
+}
+
+// One sprite (same order as kSpriteFields): its file from assets/, or a
+// generated placeholder when the file is missing. Pure CPU work, so it runs
+// on any thread.
+static Image DecodeSprite(int i) {
+    static const char* kFiles[] = {
+        "assets/player_right.png", "assets/player_left.png", "assets/player_up.png", "assets/player_down.png",
+        "assets/rival.png", "assets/berry.png", "assets/stick.png", "assets/pond.png", "assets/clue.png",
+        NULL, "assets/ui_heart.png", "assets/ui_food.png", "assets/ui_water.png", NULL,
+    };
+    Image img = kFiles[i] ? LoadImageIfExists(kFiles[i]) : (Image) { 0 };
+    if (img.width != 0) return img;
+
+    switch (i) {
+    // --- player direction sprites: circle with a visor on the facing side ---
+    case 0: return GenPlayerImage(12, 8);
+    case 1: return GenPlayerImage(2, 8);
+    case 2: return GenPlayerImage(7, 2);
+    case 3: return GenPlayerImage(7, 12);
+    case 4: return GenCircleImage(26, (Color) { 200, 60, 60, 255 }, (Color) { 0, 0, 0, 0 });
+    case 5: return GenCircleImage(20, (Color) { 180, 40, 60, 255 }, (Color) { 0, 0, 0, 0 });
+    case 6: img = GenImageColor(18, 18, (Color) { 0, 0, 0, 0 }); ImageDrawRectangle(&img, 7, 2, 4, 14, (Color) { 120, 80, 60, 255 }); return img;
+    case 7: return GenPond(56);
+    case 8: return GenCircleImage(22, (Color) { 230, 230, 40, 230 }, (Color) { 0, 0, 0, 0 });
+    case 9: return GenMoodyGrassTile(64);
+    case 10: img = GenImageColor(20, 20, (Color) { 0, 0, 0, 0 }); ImageDrawRectangle(&img, 4, 6, 12, 10, RED); return img;
+    case 11: img = GenImageColor(20, 20, (Color) { 0, 0, 0, 0 }); ImageDrawRectangle(&img, 6, 6, 8, 8, (Color) { 200, 120, 50, 255 }); return img;
+    case 12: img = GenImageColor(20, 20, (Color) { 0, 0, 0, 0 }); ImageDrawCircle(&img, 10, 10, 7, (Color) { 50, 140, 220, 255 }); return img;
+    default: return GenImageColor(4, 4, WHITE);
+    }
+}
+
+// One sound (same order as kSoundFields), with a fallback beep if missing
+static Wave DecodeWave(int i) {
+    static const char* kFiles[] = {
+        "assets/pickup_food.wav", "assets/pickup_stick.wav", "assets/drink.wav", "assets/clue.wav", "assets/craft.wav",
+    };
+    Wave w = LoadWaveIfExists(kFiles[i]);
+    if (w.frameCount != 0) return w;
+    switch (i) {
+    case 0:  return GenBeep(880.0f, 0.07f, 0.45f);
+    case 1:  return GenBeep(660.0f, 0.07f, 0.45f);
+    case 2:  return GenBeep(520.0f, 0.10f, 0.40f);
+    case 3:  return GenBeep(980.0f, 0.09f, 0.50f);
+    default: return GenBeep(180.0f, 0.10f, 0.55f); // low thunk
+    }
+}
+
+// ... compressed the way it is kept in memory: 16-bit, at most stereo
+static AdpcmSound DecodeSound(int i) {
+    Wave w = DecodeWave(i);
+    WaveFormat(&w, (int)w.sampleRate, 16, w.channels > 2 ? 2 : (int)w.channels);
+    AdpcmSound s = { NULL, ADPCM_BYTES(w.frameCount, w.channels), w.frameCount, w.sampleRate, w.channels, kSoundVolume[i] };
+    s.data = MemAlloc(s.size);
+    Adpcm_Encode(s.data, w.data, w.frameCount, w.channels);
+    UnloadWave(w);
+    return s;
+}
+
+// Decoded images -> packed atlas pages in src (the images are freed)
+static void PackSprites(AssetSources* src, Image* images) {
+    AtlasItem items[SPRITE_COUNT];
+    for (int i = 0; i < SPRITE_COUNT; i++) items[i] = (AtlasItem){ images[i], i };
+    BuildAtlas(src, items, SPRITE_COUNT);
+    for (int i = 0; i < SPRITE_COUNT; i++) UnloadImage(images[i]);
+}
+
+// Everything from loose files, serially (the packer's path)
+static void DecodeSources(AssetSources* src) {
+    *src = (AssetSources){ 0 };
+    Image images[SPRITE_COUNT];
+    for (int i = 0; i < SPRITE_COUNT; i++) images[i] = DecodeSprite(i);
+    PackSprites(src, images);
+    for (int i = 0; i < SOUND_COUNT; i++) src->sounds[i] = DecodeSound(i);
+}
+
+static void FreeSources(AssetSources* src) {
+    for (int i = 0; i < src->pageCount; i++) UnloadImage(src->pages[i]);
+    for (int i = 0; i < SOUND_COUNT; i++) MemFree(src->sounds[i].data);
+    *src = (AssetSources){ 0 };
+}
+
+// -----------------------------------------------------------------------------
+// Bundle: one file holding the finished atlas pages and SFX, written by
+// Assets_Pack and mapped read-only by Assets_Load. Little-endian:
+//   header   magic "SOAB", version, pageCount, spriteCount, soundCount
+//   pages    width, height, offset, size            (RGBA8 rows, top first)
+//   sprites  page, x, y, width, height              (float rectangle)
+//   sounds   frames, rate, channels, offset, size   (IMA ADPCM, see adpcm.h)
+//   data     pixel and sample blobs, each 16-byte aligned
+// Pages are stored exactly as they are uploaded (straight alpha, padded), so
+// loading is a texture upload straight out of the mapping.
+#define BUNDLE_VERSION      2
+#define BUNDLE_HEADER_BYTES 20
+#define BUNDLE_PAGE_BYTES   16
+#define BUNDLE_SPRITE_BYTES 20
+#define BUNDLE_SOUND_BYTES  20
+#define BUNDLE_ALIGN        16
+
+static void PutU32(unsigned char* b, unsigned v) { b[0] = (unsigned char)v; b[1] = (unsigned char)(v >> 8); b[2] = (unsigned char)(v >> 16); b[3] = (unsigned char)(v >> 24); }
+static unsigned GetU32(const unsigned char* b) { return b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned)b[3] << 24); }
+static void PutF32(unsigned char* b, float f) { unsigned v; memcpy(&v, &f, 4); PutU32(b, v); }
+static float GetF32(const unsigned char* b) { unsigned v = GetU32(b); float f; memcpy(&f, &v, 4); return f; }
+
+static unsigned AlignUp(unsigned v) { return (v + BUNDLE_ALIGN - 1) & ~(unsigned)(BUNDLE_ALIGN - 1); }
+
+bool Assets_Pack(const char* path) {
+    AssetSources src;
+    DecodeSources(&src);
+
+    unsigned dirBytes = BUNDLE_HEADER_BYTES + src.pageCount * BUNDLE_PAGE_BYTES + SPRITE_COUNT * BUNDLE_SPRITE_BYTES + SOUND_COUNT * BUNDLE_SOUND_BYTES;
+    unsigned char* dir = MemAlloc(dirBytes);
+    unsigned char* b = dir;
+    memcpy(b, "SOAB", 4);
+    PutU32(b + 4, BUNDLE_VERSION);
+    PutU32(b + 8, (unsigned)src.pageCount);
+    PutU32(b + 12, (unsigned)SPRITE_COUNT);
+    PutU32(b + 16, (unsigned)SOUND_COUNT);
+    b += BUNDLE_HEADER_BYTES;
+
+    unsigned offset = AlignUp(dirBytes);
+    for (int i = 0; i < src.pageCount; i++, b += BUNDLE_PAGE_BYTES) {
+        unsigned size = (unsigned)(src.pages[i].width * src.pages[i].height * 4);
+        PutU32(b, (unsigned)src.pages[i].width);
+        PutU32(b + 4, (unsigned)src.pages[i].height);
+        PutU32(b + 8, offset);
+        PutU32(b + 12, size);
+        offset = AlignUp(offset + size);
+    }
+    for (int i = 0; i < SPRITE_COUNT; i++, b += BUNDLE_SPRITE_BYTES) {
+        PutU32(b, (unsigned)src.spritePage[i]);
+        PutF32(b + 4, src.spriteRect[i].x);
+        PutF32(b + 8, src.spriteRect[i].y);
+        PutF32(b + 12, src.spriteRect[i].width);
+        PutF32(b + 16, src.spriteRect[i].height);
+    }
+    for (int i = 0; i < SOUND_COUNT; i++, b += BUNDLE_SOUND_BYTES) {
+        const AdpcmSound* s = &src.sounds[i];
+        PutU32(b, s->frames);
+        PutU32(b + 4, s->sampleRate);
+        PutU32(b + 8, s->channels);
+        PutU32(b + 12, offset);
+        PutU32(b + 16, s->size);
+        offset = AlignUp(offset + s->size);
+    }
+
+    FILE* f = fopen(path, "wb");
+    bool ok = f != NULL;
+    if (ok) {
+        static const unsigned char zeros[BUNDLE_ALIGN] = { 0 };
+        unsigned at = dirBytes;
+        fwrite(dir, 1, dirBytes, f);
+        for (int i = 0; i < src.pageCount + SOUND_COUNT; i++) {
+            const void* data = i < src.pageCount ? src.pages[i].data : src.sounds[i - src.pageCount].data;
+            unsigned size = i < src.pageCount ? (unsigned)(src.pages[i].width * src.pages[i].height * 4) : src.sounds[i - src.pageCount].size;
+            fwrite(zeros, 1, AlignUp(at) - at, f);
+            at = AlignUp(at);
+            fwrite(data, 1, size, f);
+            at += size;
+        }
+        ok = ferror(f) == 0;
+        fclose(f);
+    }
+    if (ok) TraceLog(LOG_INFO, "BUNDLE: wrote %s (%d pages, %d sprites, %d sounds, %u bytes)", path, src.pageCount, SPRITE_COUNT, SOUND_COUNT, offset);
+    else TraceLog(LOG_ERROR, "BUNDLE: cannot write %s", path);
+
+    MemFree(dir);
+    FreeSources(&src);
+    return ok;
+}
+
+// Point src at the bundle's contents; nothing is copied. False if the file is
+// missing, from another version, or doesn't match this build's asset list.
+static bool MapBundle(AssetSources* src, const MappedFile* m) {
+    *src = (AssetSources){ 0 };
+    const unsigned char* b = m->data;
+    if (m->size < BUNDLE_HEADER_BYTES || memcmp(b, "SOAB", 4) != 0 || GetU32(b + 4) != BUNDLE_VERSION) return false;
+    unsigned pages = GetU32(b + 8);
+    if (pages == 0 || pages > ATLAS_MAX_PAGES || GetU32(b + 12) != SPRITE_COUNT || GetU32(b + 16) != SOUND_COUNT) return false;
+    if (m->size < BUNDLE_HEADER_BYTES + pages * BUNDLE_PAGE_BYTES + SPRITE_COUNT * BUNDLE_SPRITE_BYTES + SOUND_COUNT * BUNDLE_SOUND_BYTES) return false;
+    b += BUNDLE_HEADER_BYTES;
+
+    for (unsigned i = 0; i < pages; i++, b += BUNDLE_PAGE_BYTES) {
+        unsigned w = GetU32(b), h = GetU32(b + 4), offset = GetU32(b + 8), size = GetU32(b + 12);
+        if (w == 0 || h == 0 || w > ATLAS_MAX_SIZE || h > ATLAS_MAX_SIZE || size != w * h * 4 || offset > m->size || size > m->size - offset) return false;
+        src->pages[i] = (Image){ (void*)(m->data + offset), (int)w, (int)h, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    }
+    src->pageCount = (int)pages;
+    for (int i = 0; i < SPRITE_COUNT; i++, b += BUNDLE_SPRITE_BYTES) {
+        unsigned page = GetU32(b);
+        if (page >= pages) return false;   // checked unsigned, so no huge value narrows to a negative index
+        src->spritePage[i] = (int)page;
+        src->spriteRect[i] = (Rectangle){ GetF32(b + 4), GetF32(b + 8), GetF32(b + 12), GetF32(b + 16) };
+    }
+    for (int i = 0; i < SOUND_COUNT; i++, b += BUNDLE_SOUND_BYTES) {
+        AdpcmSound s = { NULL, GetU32(b + 16), GetU32(b), GetU32(b + 4), GetU32(b + 8), kSoundVolume[i] };
+        unsigned offset = GetU32(b + 12);
+        if (s.channels < 1 || s.channels > 2 || s.size != ADPCM_BYTES(s.frames, s.channels) || offset > m->size || s.size > m->size - offset) return false;
+        s.data = (unsigned char*)(m->data + offset);   // copied out when the sound is taken
+        src->sounds[i] = s;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Loading runs in the background: workers decode images, waves and music
+// headers; the main thread (Assets_PumpLoad, once a frame) only uploads what
+// has finished -- atlas pages to the GPU, compressed SFX into Assets.
+// Sprites come first, since play can't start without them; sounds and music
+// may still be arriving after it has.
+#define MUSIC_COUNT 2
+
+typedef struct LoadJob {
+    struct AssetLoad* load;
+    int               index;
+} LoadJob;
+
+typedef struct AssetLoad {
+    double       start;
+    WorkerPool*  pool;
+    MappedFile   bundle;          // open while its contents are still being uploaded
+    bool         fromBundle;
+    AssetSources src;
+
+    // written by workers, published by the done flags
+    Image        images[SPRITE_COUNT];
+    Music        music[MUSIC_COUNT];
+    volatile int imagesLeft;      // sprite decodes still running
+    volatile int atlasDone;
+    volatile int soundDone[SOUND_COUNT];
+    volatile int musicDone[MUSIC_COUNT];
+
+    // main thread only
+    bool         atlasQueued, atlasUploaded;
+    bool         soundUploaded[SOUND_COUNT], musicTaken[MUSIC_COUNT];
+    LoadJob      jobs[SPRITE_COUNT + SOUND_COUNT + MUSIC_COUNT];
+} AssetLoad;
+
+static void DecodeSpriteJob(void* arg) {
+    LoadJob* j = arg;
+    j->load->images[j->index] = DecodeSprite(j->index);
+    Atomic_Add(&j->load->imagesLeft, -1);
+}
+
+static void PackSpritesJob(void* arg) {
+    AssetLoad* l = arg;
+    PackSprites(&l->src, l->images);
+    Atomic_Store(&l->atlasDone, 1);
+}
+
+static void DecodeSoundJob(void* arg) {
+    LoadJob* j = arg;
+    j->load->src.sounds[j->index] = DecodeSound(j->index);
+    Atomic_Store(&j->load->soundDone[j->index], 1);
+}
+
+// Opening a stream parses the header and, for MP3, scans every frame to
+// count them -- the slow part of music loading. raylib registers the
+// stream's buffer under its audio lock, so this is safe off the main thread.
+static void OpenMusicJob(void* arg) {
+    LoadJob* j = arg;
+    j->load->music[j->index] = LoadMusicIfExists(j->index == 0 ? "bg_day" : "bg_night");   // assets/<name>.(ogg|mp3|wav)
+    Atomic_Store(&j->load->musicDone[j->index], 1);
+}
+
+void Assets_BeginLoad(Assets* a, WorkerPool* pool) {
+    AssetLoad* l = MemAlloc(sizeof(AssetLoad));
+    l->start = Timer_Now();
+    l->pool = pool;
+    a->load = l;
+    a->loadProgress = 0.0f;
+    a->spritesReady = false;
+
+    // the bundle when there is one: already packed and decoded, nothing for workers to do
+    l->fromBundle = MappedFile_Open(&l->bundle, ASSETS_BUNDLE_PATH);
+    if (l->fromBundle && !MapBundle(&l->src, &l->bundle)) {
+        TraceLog(LOG_WARNING, "BUNDLE: %s is stale or damaged, loading loose files", ASSETS_BUNDLE_PATH);
+        MappedFile_Close(&l->bundle);
+        l->fromBundle = false;
+    }
+    if (l->fromBundle) {
+        l->atlasQueued = true;
+        l->atlasDone = 1;
+        for (int i = 0; i < SOUND_COUNT; i++) l->soundDone[i] = 1;
+    }
+
+    // sprites first so they are first in the queue
+    int job = 0;
+    if (!l->fromBundle) {
+        l->imagesLeft = SPRITE_COUNT;
+        for (int i = 0; i < SPRITE_COUNT; i++, job++) {
+            l->jobs[job] = (LoadJob){ l, i };
+            WorkerPool_Submit(pool, DecodeSpriteJob, &l->jobs[job]);
+        }
+        for (int i = 0; i < SOUND_COUNT; i++, job++) {
+            l->jobs[job] = (LoadJob){ l, i };
+            WorkerPool_Submit(pool, DecodeSoundJob, &l->jobs[job]);
+        }
+    }
+    for (int i = 0; i < MUSIC_COUNT; i++, job++) {
+        l->jobs[job] = (LoadJob){ l, i };
+        WorkerPool_Submit(pool, OpenMusicJob, &l->jobs[job]);
+    }
+    Assets_PumpLoad(a);
+}
+
+void Assets_PumpLoad(Assets* a) {
+    AssetLoad* l = a->load;
+    if (!l) return;
+    PROF_ZONE(zone, "Assets_PumpLoad");
+    int done = 0, total = SPRITE_COUNT + 1 + SOUND_COUNT + MUSIC_COUNT;
+
+    // --- sprites: every image decoded -> pack (worker) -> upload ---
+    done += SPRITE_COUNT - (l->fromBundle ? 0 : Atomic_Load(&l->imagesLeft));
+    if (!l->atlasQueued && Atomic_Load(&l->imagesLeft) == 0) {
+        l->atlasQueued = true;
+        WorkerPool_Submit(l->pool, PackSpritesJob, l);
+    }
+    if (!l->atlasUploaded && Atomic_Load(&l->atlasDone)) {
+        for (int i = 0; i < l->src.pageCount; i++) {
+            Texture2D tex = LoadTextureFromImage(l->src.pages[i]);
+            SetTextureFilter(tex, TEXTURE_FILTER_POINT);
+            SetTextureWrap(tex, TEXTURE_WRAP_CLAMP);
+            a->atlas[i] = tex;
+            if (!l->fromBundle) UnloadImage(l->src.pages[i]);
+        }
+        a->atlasPages = l->src.pageCount;
+        for (int i = 0; i < SPRITE_COUNT; i++) *SpriteAt(a, i) = (Sprite){ a->atlas[l->src.spritePage[i]], l->src.spriteRect[i] };
+
+        // shapes (shadows, bars, spear) sample the atlas' white texels too, so they
+        // don't force a texture switch between sprites
+        Rectangle w = a->white.src;
+        SetShapesTexture(a->white.tex, (Rectangle) { w.x + 1, w.y + 1, w.width - 2, w.height - 2 });
+        l->atlasUploaded = true;
+        a->spritesReady = true;
+    }
+    done += l->atlasUploaded;
+
+    // --- SFX ---
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        if (!l->soundUploaded[i] && Atomic_Load(&l->soundDone[i])) {
+            AdpcmSound* s = SoundAt(a, i);
+            *s = l->src.sounds[i];
+            if (l->fromBundle) {   // the mapping closes after loading
+                s->data = MemAlloc(s->size);
+                memcpy(s->data, l->src.sounds[i].data, s->size);
+            }
+            l->soundUploaded[i] = true;
+        }
+        done += l->soundUploaded[i];
+    }
+
+    // --- music (streamed; the audio module starts it whenever it shows up) ---
+    for (int i = 0; i < MUSIC_COUNT; i++) {
+        if (!l->musicTaken[i] && Atomic_Load(&l->musicDone[i])) {
+            Music m = l->music[i];
+            if (m.ctxData) { m.looping = true; SetMusicVolume(m, 0.0f); }
+            if (i == 0) a->bgDay = m; else a->bgNight = m;
+            l->musicTaken[i] = true;
+        }
+        done += l->musicTaken[i];
+    }
+
+    a->loadProgress = (float)done / (float)total;
+    if (done == total) {
+        TraceLog(LOG_INFO, "ASSETS: loaded from %s in %.1f ms", l->fromBundle ? ASSETS_BUNDLE_PATH : "loose files", (Timer_Now() - l->start) * 1e3);
+        if (l->fromBundle) MappedFile_Close(&l->bundle);   // textures and sounds hold their own copies now
+        MemFree(l);
+        a->load = NULL;
+    }
+    PROF_END(zone);
+}
+
+void Assets_Load(Assets* a) {
+    PROF_ZONE(zone, "Assets_Load");
+    Assets_BeginLoad(a, NULL);   // no pool: every job has already run inline
+    while (a->load) Assets_PumpLoad(a);
+    PROF_END(zone);
 }
 
 void Assets_Unload(Assets* a) {
-    UnloadTexture(a->texPlayerRight);
-    UnloadTexture(a->texPlayerLeft);
-    UnloadTexture(a->texPlayerUp);
-    UnloadTexture(a->texPlayerDown);
-    UnloadTexture(a->texRival); UnloadTexture(a->texBerry);
-    UnloadTexture(a->texStick);  UnloadTexture(a->texPond);  UnloadTexture(a->texClue);
-    UnloadTexture(a->uiHeart);   UnloadTexture(a->uiFood);   UnloadTexture(a->uiWater);
+    // jobs still in flight write into the loader: let them land first
+    while (a->load) { Assets_PumpLoad(a); if (a->load) Thread_Sleep(1); }
 
-    
+    SetShapesTexture((Texture2D) { 0 }, (Rectangle) { 0 });   // back to raylib's default
+    for (int i = 0; i < a->atlasPages; i++) UnloadTexture(a->atlas[i]);
+    a->atlasPages = 0;
 
     // SFX
-    if (a->sPickupFood.frameCount)  UnloadSound(a->sPickupFood);
-    if (a->sPickupStick.frameCount) UnloadSound(a->sPickupStick);
-    if (a->sDrink.frameCount)       UnloadSound(a->sDrink);
-    if (a->sClue.frameCount)        UnloadSound(a->sClue);
-    if (a->sCraft.frameCount)       UnloadSound(a->sCraft);
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        AdpcmSound* s = SoundAt(a, i);
+        MemFree(s->data);
+        *s = (AdpcmSound){ 0 };
+    }
 
     // Music
     if (a->bgDay.ctxData)   UnloadMusicStream(a->bgDay);
     if (a->bgNight.ctxData) UnloadMusicStream(a->bgNight);
 }
+
+// -----------------------------------------------------------------------------
+SpriteStats g_spriteStats;
+SpriteStats g_spriteStatsPrev;
+
+void Assets_DrawSprite(Sprite s, Rectangle dst, Vector2 origin, float rotation, Color tint) {
+    static unsigned lastPage = 0;
+    if (g_spriteStats.sprites == 0 || s.tex.id != lastPage) g_spriteStats.pageSwitches++;
+    lastPage = s.tex.id;
+    g_spriteStats.sprites++;
+    g_spriteStats.vertices += 4;
+    DrawTexturePro(s.tex, s.src, dst, origin, rotation, tint);
+}
+
+void Assets_ResetStats(void) {
+    g_spriteStatsPrev = g_spriteStats;
+    g_spriteStats = (SpriteStats){ 0 };
+}
+
+void Assets_BeginMode2D(Camera2D cam)                   { g_spriteStats.flushes++; BeginMode2D(cam); }
+void Assets_EndMode2D(void)                             { g_spriteStats.flushes++; EndMode2D(); }
+void Assets_BeginTextureMode(RenderTexture2D target)    { g_spriteStats.flushes++; BeginTextureMode(target); }
+void Assets_EndTextureMode(void)                        { g_spriteStats.flushes++; EndTextureMode(); }
+void Assets_BeginScissorMode(int x, int y, int w, int h) { g_spriteStats.flushes++; BeginScissorMode(x, y, w, h); }
+void Assets_EndScissorMode(void)                        { g_spriteStats.flushes++; EndScissorMode(); }
+void Assets_BeginBlendMode(int mode)                    { g_spriteStats.flushes++; BeginBlendMode(mode); }
+void Assets_EndBlendMode(void)                          { g_spriteStats.flushes++; EndBlendMode(); }
+void Assets_BeginShaderMode(Shader shader)              { g_spriteStats.flushes++; BeginShaderMode(shader); }
+void Assets_EndShaderMode(void)                         { g_spriteStats.flushes++; EndShaderMode(); }
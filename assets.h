@@ -1,30 +1,95 @@
 #ifndef ASSETS_H
 #define ASSETS_H
 #include "raylib.h"
+#include "adpcm.h"
+#include <stdbool.h>
 #pragma once
 
+// A sprite is a sub-rectangle of an atlas page. All sprites (loaded and
+// generated placeholders) are packed into a few pages at load time so the
+// world and HUD keep drawing from the same texture and raylib can batch.
+typedef struct Sprite {
+    Texture2D tex;    // atlas page
+    Rectangle src;    // region on the page
+} Sprite;
+
+#define ATLAS_MAX_PAGES 4
+
+// Per-frame sprite submission counters (reset by Assets_ResetStats)
+typedef struct SpriteStats {
+    int sprites;      // quads submitted through Assets_DrawSprite
+    int vertices;     // 4 per quad
+    int pageSwitches; // consecutive sprites on different pages (each one binds a texture and splits a batch)
+    int flushes;      // render-state changes that flush the batch, counted by the Assets_Begin*/End* wrappers
+} SpriteStats;
+
+extern SpriteStats g_spriteStats;
+extern SpriteStats g_spriteStatsPrev;   // totals of the last finished frame
+
 typedef struct Assets {
-    Texture2D texPlayerRight;
-    Texture2D texPlayerLeft;
-    Texture2D texPlayerUp;
-    Texture2D texPlayerDown;
-    Texture2D texRival, texBerry, texStick, texPond, texClue;
-
-    Texture2D uiHeart, uiFood, uiWater;
-    // --- SFX ---
-    Sound sPickupFood;
-    Sound sPickupStick;
-    Sound sDrink;
-    Sound sClue;
-    Sound sCraft;
+    Texture2D atlas[ATLAS_MAX_PAGES];
+    int       atlasPages;
+
+    Sprite sprPlayerRight;
+    Sprite sprPlayerLeft;
+    Sprite sprPlayerUp;
+    Sprite sprPlayerDown;
+    Sprite sprRival, sprBerry, sprStick, sprPond, sprClue;
+
+    Sprite sprGrass;   // ground tile
+    Sprite uiHeart, uiFood, uiWater;
+    Sprite white;      // opaque white texels; shapes are drawn from it too
+    // --- SFX (compressed; the audio module expands them on demand) ---
+    AdpcmSound sPickupFood;
+    AdpcmSound sPickupStick;
+    AdpcmSound sDrink;
+    AdpcmSound sClue;
+    AdpcmSound sCraft;
 
     // --- Background music (streamed) ---
     Music bgDay;
     Music bgNight;
+
+    // --- background loading (Assets_BeginLoad) ---
+    struct AssetLoad* load;   // NULL once everything is in
+    float loadProgress;       // 0..1
+    bool  spritesReady;       // atlas uploaded: gameplay can draw
 } Assets;
 
-void Assets_Load(Assets* a);   // tries PNGs in ./assets; falls back to generated textures
-void Assets_Unload(Assets* a);
+#define ASSETS_BUNDLE_PATH "assets/assets.pak"
+
+struct WorkerPool;
+
+// Loads ASSETS_BUNDLE_PATH when present (mapped, no decoding); otherwise tries
+// PNGs/WAVs in ./assets and falls back to generated placeholders.
+// Assets_BeginLoad hands the decoding to the pool and returns at once; call
+// Assets_PumpLoad every frame on the main thread to upload what has finished.
+// Assets_Load does the whole thing inline and returns when done. Either way
+// the source and duration are logged ("ASSETS: loaded from ..."), so the two
+// paths can be compared by running once with the bundle and once without.
+void Assets_BeginLoad(Assets* a, struct WorkerPool* pool);
+void Assets_PumpLoad(Assets* a);
+void Assets_Load(Assets* a);
+void Assets_Unload(Assets* a);   // waits for a load still in flight
+
+// Offline: decode the loose files (placeholders included), pack the atlas and
+// write everything Assets_Load needs into one bundle. Needs no window.
+bool Assets_Pack(const char* path);
+
+void Assets_DrawSprite(Sprite s, Rectangle dst, Vector2 origin, float rotation, Color tint);
+void Assets_ResetStats(void);
+
+// raylib's render-state changes, each of which submits the batch. Draw code
+// calls these instead of the raylib ones so SpriteStats.flushes is exact.
+void Assets_BeginMode2D(Camera2D cam);
+void Assets_EndMode2D(void);
+void Assets_BeginTextureMode(RenderTexture2D target);
+void Assets_EndTextureMode(void);
+void Assets_BeginScissorMode(int x, int y, int w, int h);
+void Assets_EndScissorMode(void);
+void Assets_BeginBlendMode(int mode);
+void Assets_EndBlendMode(void);
+void Assets_BeginShaderMode(Shader shader);
+void Assets_EndShaderMode(void);
 
 #endif
-#pragma once
@@ -0,0 +1,218 @@
+#include "audio.h"
+#include "assets.h"
+#include "adpcm.h"
+#include "profile.h"
+#include "thread.h"
+#include "raylib.h"
+#include <string.h>   // memcpy
+
+static Assets* s_assets;   // NULL while silent
+
+// Expanded SFX. raylib converts a Sound to the mixer's format (32-bit float at
+// the device's channel count), so one resident Sound costs 4-8x its 16-bit
+// source and 16-32x its ADPCM form; only the ones in use are kept.
+typedef struct SfxSlot {
+    Sound    sound;      // frameCount 0 = not resident
+    size_t   bytes;
+    unsigned lastUse;
+} SfxSlot;
+
+static SfxSlot  s_sfx[SFX_COUNT];
+static size_t   s_sfxBudget = AUDIO_SFX_BUDGET_DEFAULT;
+static size_t   s_sfxResident;
+static unsigned s_sfxClock;
+static unsigned s_mixRate = 48000;   // the mixer's; learned from the first expanded Sound
+static unsigned s_mixChannels = 2;
+
+static const AdpcmSound* ClipOf(Sfx s) {
+    switch (s) {
+    case SFX_PICKUP_FOOD:  return &s_assets->sPickupFood;
+    case SFX_PICKUP_STICK: return &s_assets->sPickupStick;
+    case SFX_DRINK:        return &s_assets->sDrink;
+    case SFX_CLUE:         return &s_assets->sClue;
+    case SFX_CRAFT:        return &s_assets->sCraft;
+    default: return NULL;
+    }
+}
+
+static void DropSfx(SfxSlot* slot) {
+    UnloadSound(slot->sound);
+    s_sfxResident -= slot->bytes;
+    *slot = (SfxSlot){ 0 };
+}
+
+// Least recently played first, until under budget. `keep` (the sound about
+// to play) and anything still audible are skipped, so a single sound larger
+// than the budget can still play.
+static void TrimSfx(int keep) {
+    while (s_sfxResident > s_sfxBudget) {
+        int lru = -1;
+        for (int i = 0; i < SFX_COUNT; i++) {
+            const SfxSlot* slot = &s_sfx[i];
+            if (i == keep || !slot->sound.frameCount || IsSoundPlaying(slot->sound)) continue;
+            if (lru < 0 || slot->lastUse < s_sfx[lru].lastUse) lru = i;
+        }
+        if (lru < 0) return;
+        DropSfx(&s_sfx[lru]);
+    }
+}
+
+static bool ExpandSfx(Sfx s) {
+    const AdpcmSound* clip = ClipOf(s);
+    if (!clip || !clip->data) return false;   // not loaded (yet)
+    short* pcm = MemAlloc(clip->frames * clip->channels * sizeof(short));
+    Adpcm_Decode(pcm, clip->data, clip->frames, clip->channels);
+    Sound snd = LoadSoundFromWave((Wave) { clip->frames, clip->sampleRate, 16, clip->channels, pcm });
+    MemFree(pcm);
+    if (!snd.frameCount) return false;
+    SetSoundVolume(snd, clip->volume);
+
+    if (clip->frames) {
+        s_mixRate = (unsigned)((unsigned long long)snd.frameCount * clip->sampleRate / clip->frames);
+        s_mixChannels = snd.stream.channels;
+    }
+
+    SfxSlot* slot = &s_sfx[s];
+    slot->sound = snd;
+    slot->bytes = (size_t)snd.frameCount * snd.stream.channels * (snd.stream.sampleSize / 8);
+    s_sfxResident += slot->bytes;
+    TrimSfx(s);
+    return true;
+}
+
+void Audio_PlaySfx(Sfx s) {
+    if (!s_assets || (unsigned)s >= SFX_COUNT) return;
+    SfxSlot* slot = &s_sfx[s];
+    if (!slot->sound.frameCount && !ExpandSfx(s)) return;
+    slot->lastUse = ++s_sfxClock;
+    PlaySound(slot->sound);
+}
+
+void Audio_SetSfxBudget(size_t bytes) {
+    s_sfxBudget = bytes;
+    TrimSfx(-1);
+}
+
+size_t Audio_SfxResident(void) { return s_sfxResident; }
+
+// Expand one not-yet-resident sound per frame while it fits, so the first
+// Gather or Craft doesn't pay for the decode. The estimate is float PCM
+// resampled to the mixer's rate, which is what raylib keeps. A sound kept
+// over budget only because it was playing goes first.
+static void PrewarmSfx(void) {
+    TrimSfx(-1);
+    for (int i = 0; i < SFX_COUNT; i++) {
+        const AdpcmSound* clip = ClipOf((Sfx)i);
+        if (s_sfx[i].sound.frameCount || !clip->data || !clip->sampleRate) continue;
+        size_t frames = (size_t)((unsigned long long)clip->frames * s_mixRate / clip->sampleRate);
+        if (s_sfxResident + frames * s_mixChannels * sizeof(float) > s_sfxBudget) continue;
+        ExpandSfx((Sfx)i);
+        return;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Music is fed by its own thread: decoding MP3 and refilling the stream
+// buffers never waits on a frame, so a hitch on the main thread can't starve
+// the mixer. The game only publishes volumes (atomics, no locks); the thread
+// owns every raylib call on the streams, and raylib takes its audio lock
+// inside them. A track faded below MUSIC_SILENT is paused, which also stops
+// its decoding; it resumes where it left off when it fades back in.
+#define MUSIC_TRACKS  2
+#define MUSIC_SILENT  0.002f   // about -54 dB
+#define MUSIC_FEED_MS 5        // well under one stream sub-buffer
+
+typedef struct MusicTrack {
+    Music        music;        // written once by the main thread before `ready`
+    volatile int ready;
+    volatile int volume;       // float bits
+    bool         taken;        // main thread: handed to the feeder
+    bool         started, running;   // feeder thread only
+    float        applied;            // feeder thread only
+} MusicTrack;
+
+static MusicTrack   s_tracks[MUSIC_TRACKS];
+static volatile int s_musicOn;      // Audio_StartMusic was called
+static volatile int s_musicPaused;
+static volatile int s_musicQuit;
+static Thread       s_musicThread;
+static bool         s_musicThreadUp;
+
+static void  StoreVolume(volatile int* v, float f) { int bits; memcpy(&bits, &f, sizeof(bits)); Atomic_Store(v, bits); }
+static float LoadVolume(volatile int* v) { int bits = Atomic_Load(v); float f; memcpy(&f, &bits, sizeof(f)); return f; }
+
+static void FeedTrack(MusicTrack* t, bool on) {
+    float vol = LoadVolume(&t->volume);
+    bool audible = on && vol > MUSIC_SILENT;
+    if (audible && !t->running) {
+        if (t->started) ResumeMusicStream(t->music);
+        else PlayMusicStream(t->music);
+        t->started = t->running = true;
+        t->applied = -1.0f;
+    }
+    else if (!audible && t->running) {
+        PauseMusicStream(t->music);
+        t->running = false;
+    }
+    if (!t->running) return;
+    if (vol != t->applied) { SetMusicVolume(t->music, vol); t->applied = vol; }
+    UpdateMusicStream(t->music);
+}
+
+static void MusicThread(void* arg) {
+    (void)arg;
+    Prof_SetThreadName("music");
+    while (!Atomic_Load(&s_musicQuit)) {
+        PROF_ZONE(zone, "Music_Feed");
+        bool on = Atomic_Load(&s_musicOn) && !Atomic_Load(&s_musicPaused);
+        for (int i = 0; i < MUSIC_TRACKS; i++)
+            if (Atomic_Load(&s_tracks[i].ready)) FeedTrack(&s_tracks[i], on);
+        PROF_END(zone);
+        Thread_Sleep(MUSIC_FEED_MS);
+    }
+    for (int i = 0; i < MUSIC_TRACKS; i++)
+        if (Atomic_Load(&s_tracks[i].ready) && s_tracks[i].started) StopMusicStream(s_tracks[i].music);
+}
+
+void Audio_StartMusic(float dayVol, float nightVol) {
+    if (!s_assets) return;
+    Audio_SetMusicVolume(dayVol, nightVol);
+    Atomic_Store(&s_musicOn, 1);
+}
+
+void Audio_SetMusicVolume(float dayVol, float nightVol) {
+    StoreVolume(&s_tracks[0].volume, dayVol);
+    StoreVolume(&s_tracks[1].volume, nightVol);
+}
+
+void Audio_SetMusicPaused(bool paused) { Atomic_Store(&s_musicPaused, paused); }
+
+void Audio_UpdateMusic(void) {
+    if (!s_assets) return;
+    PrewarmSfx();
+    // streams still loading when the music started join in once they arrive
+    const Music* loaded[MUSIC_TRACKS] = { &s_assets->bgDay, &s_assets->bgNight };
+    for (int i = 0; i < MUSIC_TRACKS; i++) {
+        if (s_tracks[i].taken || !loaded[i]->ctxData) continue;
+        s_tracks[i].music = *loaded[i];
+        s_tracks[i].taken = true;
+        Atomic_Store(&s_tracks[i].ready, 1);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void Audio_Init(Assets* assets) {
+    s_assets = assets;
+    if (assets && !s_musicThreadUp) s_musicThreadUp = Thread_Start(&s_musicThread, MusicThread, NULL);
+}
+
+void Audio_Shutdown(void) {
+    if (s_musicThreadUp) {
+        Atomic_Store(&s_musicQuit, 1);
+        Thread_Join(&s_musicThread);
+        s_musicThreadUp = false;
+    }
+    for (int i = 0; i < SFX_COUNT; i++)
+        if (s_sfx[i].sound.frameCount) DropSfx(&s_sfx[i]);
+    s_assets = NULL;
+}
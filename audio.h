@@ -0,0 +1,39 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+#include <stdbool.h>
+#include <stddef.h>
+#pragma once
+
+struct Assets;
+
+// Game code asks for sounds by id and never touches raylib audio handles,
+// so the simulation runs the same with or without an audio device.
+typedef enum Sfx {
+    SFX_PICKUP_FOOD = 0,
+    SFX_PICKUP_STICK,
+    SFX_DRINK,
+    SFX_CLUE,
+    SFX_CRAFT,
+    SFX_COUNT
+} Sfx;
+
+void Audio_Init(struct Assets* assets);   // NULL (or never called) = silent
+void Audio_Shutdown(void);                // before Assets_Unload and CloseAudioDevice
+void Audio_PlaySfx(Sfx s);
+
+// SFX live compressed in Assets and are expanded to mixer PCM when needed. The
+// budget caps the expanded copies kept around; the least recently played go
+// first, though a sound that is playing always stays. The default holds the
+// short clips; the whole shipped set expands to about 2 MB at 48 kHz.
+#define AUDIO_SFX_BUDGET_DEFAULT (512u << 10)
+void   Audio_SetSfxBudget(size_t bytes);
+size_t Audio_SfxResident(void);           // bytes of expanded SFX right now
+
+// Day and night tracks play together; the game cross-fades their volumes.
+// A feeder thread decodes and refills them, so these only publish settings.
+void Audio_StartMusic(float dayVol, float nightVol);
+void Audio_SetMusicVolume(float dayVol, float nightVol);
+void Audio_SetMusicPaused(bool paused);
+void Audio_UpdateMusic(void);             // once per rendered frame: hands over late streams, prewarms SFX
+
+#endif
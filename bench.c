@@ -0,0 +1,296 @@
+#include "bench.h"
+#include "raylib.h"
+#include "raymath.h"
+#include "nodes.h"
+#include "flow.h"
+#include "light.h"
+#include "particles.h"
+#include "world.h"
+#include "worldgen.h"
+#include "thread.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// xorshift so both layouts see the exact same positions
+static unsigned BenchRand(unsigned* s) { *s ^= *s << 13; *s ^= *s >> 17; *s ^= *s << 5; return *s; }
+static float    BenchFrand(unsigned* s, float a, float b) { return a + (BenchRand(s) & 0xFFFFFF) / (float)0xFFFFFF * (b - a); }
+
+// -----------------------------------------------------------------------------
+// Node layout: the old array-of-structs Node[] against the paged SoA NodeStore.
+// The world grows with the node count so density matches the shipped map.
+typedef struct AosNode {
+    Vector2  pos;
+    NodeType type;
+    bool     taken;
+} AosNode;
+
+static float AosRadius(NodeType t) {
+    return ((t == NODE_POND) ? 48.0f : (t == NODE_CLUE) ? 36.0f : 24.0f) * NODE_SCALE;
+}
+
+int Bench_Nodes(void) {
+    const int sizes[] = { 256, 10000, 1000000 };
+    const int queries = 1000;
+
+    printf("%-9s %14s %14s %14s %14s\n", "nodes", "aos walk ns/n", "soa walk ns/n", "aos query us", "soa query us");
+    for (int k = 0; k < 3; k++) {
+        int n = sizes[k];
+        float side = sqrtf((float)n * 240000.0f);   // ~50 nodes on 4000x3000
+        unsigned seed = 12345u;
+
+        AosNode* aos = MemAlloc(n * sizeof(AosNode));
+        NodeStore soa;
+        Nodes_Init(&soa);
+        for (int i = 0; i < n; i++) {
+            NodeType t = (NodeType)(BenchRand(&seed) % NODE_TYPE_COUNT);
+            Vector2 p = { BenchFrand(&seed, 0.0f, side), BenchFrand(&seed, 0.0f, side) };
+            aos[i] = (AosNode){ p, t, false };
+            NodeId id = Nodes_Add(&soa, t, p);
+            if (t != NODE_POND && (i & 3) == 0) { aos[i].taken = true; Nodes_Take(&soa, id); }
+        }
+
+        // draw-style walk: visit every untaken node, per-type work per node
+        int reps = (n < 100000) ? 2000000 / n + 1 : 3;
+        volatile float sink = 0.0f;
+        double t0 = Timer_Now();
+        for (int r = 0; r < reps; r++) {
+            float acc = 0.0f;
+            for (int i = 0; i < n; i++) {
+                const AosNode* a = &aos[i];
+                switch (a->type) {
+                case NODE_BERRY: if (!a->taken) acc += a->pos.x * 16.0f; break;
+                case NODE_STICK: if (!a->taken) acc += a->pos.x * 12.0f; break;
+                case NODE_POND:  acc += a->pos.x * 64.0f; break;
+                case NODE_CLUE:  if (!a->taken) acc += a->pos.x * 18.0f; break;
+                default: break;
+                }
+            }
+            sink += acc;
+        }
+        double aosWalk = (Timer_Now() - t0) / reps / n * 1e9;
+
+        static const float W[NODE_TYPE_COUNT] = { 16.0f, 12.0f, 64.0f, 18.0f };
+        t0 = Timer_Now();
+        for (int r = 0; r < reps; r++) {
+            float acc = 0.0f;
+            for (int t = 0; t < NODE_TYPE_COUNT; t++) {
+                for (int pg = soa.firstPage[t]; pg >= 0; pg = soa.pages[pg]->nextOfType) {
+                    const NodePage* page = soa.pages[pg];
+                    for (int i = 0; i < page->count; i++) {
+                        if (!page->taken[i]) acc += page->pos[i].x * W[t];
+                    }
+                }
+            }
+            sink += acc;
+        }
+        double soaWalk = (Timer_Now() - t0) / reps / n * 1e9;
+
+        // proximity: the old Gather() linear scan against the spatial hash
+        int qreps = (n <= 10000) ? queries : queries / 20;
+        unsigned qseed = 777u;
+        int hits = 0;
+        t0 = Timer_Now();
+        for (int q = 0; q < qreps; q++) {
+            Vector2 p = { BenchFrand(&qseed, 0.0f, side), BenchFrand(&qseed, 0.0f, side) };
+            for (int i = 0; i < n; i++) {
+                if (aos[i].type != NODE_POND && aos[i].taken) continue;
+                if (Vector2Distance(p, aos[i].pos) > AosRadius(aos[i].type)) continue;
+                hits++;
+                break;
+            }
+        }
+        double aosQuery = (Timer_Now() - t0) / qreps * 1e6;
+
+        qseed = 777u;
+        t0 = Timer_Now();
+        for (int q = 0; q < qreps; q++) {
+            Vector2 p = { BenchFrand(&qseed, 0.0f, side), BenchFrand(&qseed, 0.0f, side) };
+            if (Nodes_FindInteractable(&soa, p) != NODE_NONE) hits--;
+        }
+        double soaQuery = (Timer_Now() - t0) / qreps * 1e6;
+
+        printf("%-9d %14.3f %14.3f %14.3f %14.3f\n", n, aosWalk, soaWalk, aosQuery, soaQuery);
+        (void)sink; (void)hits;
+
+        Nodes_Free(&soa);
+        MemFree(aos);
+    }
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Flow field on the 4000x3000 home map: full-window rebuild time and the
+// per-agent steering lookup, at several cell sizes. The map is pond-heavy
+// (40 ponds against the shipped 6) so the search has obstacles to route around.
+int Bench_Flow(void) {
+    const float cells[] = { 16.0f, 32.0f, 64.0f, 128.0f };
+    const int   ponds = 40, agents = 10000, rebuilds = 50, passes = 100;
+
+    NodeStore nodes;
+    Nodes_Init(&nodes);
+    unsigned seed = 4242u;
+    for (int i = 0; i < ponds; i++) {
+        Nodes_Add(&nodes, NODE_POND, (Vector2) { BenchFrand(&seed, 0.0f, 4000.0f), BenchFrand(&seed, 0.0f, 3000.0f) });
+    }
+
+    Vector2* pos = MemAlloc(agents * sizeof(Vector2));
+    for (int i = 0; i < agents; i++) pos[i] = (Vector2){ BenchFrand(&seed, 0.0f, 4000.0f), BenchFrand(&seed, 0.0f, 3000.0f) };
+
+    printf("%-6s %9s %8s %10s %12s %12s %9s\n", "cell", "grid", "cells", "blocked %", "rebuild ms", "lookup ns", "KB");
+    for (int k = 0; k < 4; k++) {
+        float cell = cells[k];
+        int w = (int)ceilf(4000.0f / cell), h = (int)ceilf(3000.0f / cell);
+        FlowField f;
+        Flow_Init(&f, cell, w, h);
+
+        unsigned tseed = 99u;
+        double t0 = Timer_Now();
+        for (int r = 0; r < rebuilds; r++) {
+            Flow_Build(&f, &nodes, 0, 0, (Vector2) { BenchFrand(&tseed, 0.0f, 4000.0f), BenchFrand(&tseed, 0.0f, 3000.0f) });
+        }
+        double rebuildMs = (Timer_Now() - t0) / rebuilds * 1e3;
+
+        int blocked = -(2 * (w + 2) + 2 * h);   // minus the border
+        for (int i = 0; i < (w + 2) * (h + 2); i++) blocked += f.blocked[i];
+
+        volatile float sink = 0.0f;
+        t0 = Timer_Now();
+        for (int r = 0; r < passes; r++) {
+            float acc = 0.0f;
+            for (int i = 0; i < agents; i++) {
+                Vector2 d;
+                if (Flow_Direction(&f, pos[i], &d)) acc += d.x;
+            }
+            sink += acc;
+        }
+        double lookupNs = (Timer_Now() - t0) / passes / agents * 1e9;
+        (void)sink;
+
+        size_t bytes = (size_t)(w + 2) * (h + 2) * (2 + sizeof(unsigned) + 4 * sizeof(int));
+        printf("%-6.0f %4dx%-4d %8d %10.1f %12.3f %12.2f %9.0f\n", cell, w, h, w * h,
+            100.0 * blocked / (w * h), rebuildMs, lookupNs, bytes / 1024.0);
+        Flow_Free(&f);
+    }
+
+    MemFree(pos);
+    Nodes_Free(&nodes);
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Lightmap: a 1080p screen of lights with radius 80..240 px. Occluders are
+// pond-sized circles; the count per light is capped, so cost should follow
+// lit area rather than light count.
+int Bench_Light(void) {
+    const int counts[] = { 1, 8, 32, 64 };
+    const int occluders[] = { 0, 24 };
+    const int builds = 200;
+
+    Lightmap m;
+    Lightmap_Init(&m);
+    printf("%-7s %10s %10s\n", "lights", "occluders", "build ms");
+    for (int o = 0; o < 2; o++) {
+        for (int k = 0; k < 4; k++) {
+            unsigned seed = 777u;
+            Lightmap_Begin(&m, 1920, 1080, (Color) { 100, 100, 110, 255 });
+            for (int i = 0; i < occluders[o]; i++)
+                Lightmap_AddOccluder(&m, (Vector2) { BenchFrand(&seed, 0.0f, 1920.0f), BenchFrand(&seed, 0.0f, 1080.0f) }, 58.0f);
+            for (int i = 0; i < counts[k]; i++) {
+                Vector2 p = { BenchFrand(&seed, 0.0f, 1920.0f), BenchFrand(&seed, 0.0f, 1080.0f) };
+                float   r = BenchFrand(&seed, 80.0f, 240.0f);
+                if (i % 4 == 0) Lightmap_AddCone(&m, p, r * 1.5f, BenchFrand(&seed, 0.0f, 2.0f * PI), 42.0f * DEG2RAD, WHITE, 0.9f);
+                else Lightmap_AddPoint(&m, p, r, GOLD, 0.6f);
+            }
+
+            double t0 = Timer_Now();
+            for (int b = 0; b < builds; b++) Lightmap_Build(&m);
+            printf("%-7d %10d %10.3f\n", counts[k], occluders[o], (Timer_Now() - t0) / builds * 1e3);
+        }
+    }
+    Lightmap_Free(&m);
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Particle pool: a steady state of n live particles, emitting what dies each
+// step, as in a rainy night. Update is the SIMD integrate over the ring.
+int Bench_Particles(void) {
+    const int counts[] = { 1024, 8192, PARTICLE_CAP / 2, PARTICLE_CAP };
+    const int steps = 600;
+    const float dt = 1.0f / 60.0f;
+
+    Particles ps;
+    Particles_Init(&ps, 4242u);
+    ParticleEmitter e = { .kind = PARTICLE_RAIN, .color = { 170, 190, 230, 140 }, .life = 1.0f, .lifeJitter = 0.5f,
+        .speed = 500.0f, .speedJitter = 60.0f, .angle = 1.8f, .spread = 0.05f, .gravity = 0.0f, .size = 1.5f,
+        .area = { 960.0f, 20.0f } };
+    printf("%-7s %10s %10s %10s\n", "live", "emit us", "update us", "evicted");
+    for (int k = 0; k < 4; k++) {
+        Particles_Clear(&ps);
+        ps.evicted = 0;
+        // rate that keeps about counts[k] alive at the mean life
+        e.rate = counts[k] / e.life;
+        e.carry = 0.0f;
+        for (int s = 0; s < 120; s++) { Particles_RunEmitter(&ps, &e, (Vector2) { 960.0f, 0.0f }, dt); Particles_Update(&ps, dt); }
+
+        double tEmit = 0.0, tUpdate = 0.0;
+        for (int s = 0; s < steps; s++) {
+            double t0 = Timer_Now();
+            Particles_RunEmitter(&ps, &e, (Vector2) { 960.0f, 0.0f }, dt);
+            double t1 = Timer_Now();
+            Particles_Update(&ps, dt);
+            tEmit += t1 - t0;
+            tUpdate += Timer_Now() - t1;
+        }
+        printf("%-7d %10.2f %10.2f %10u\n", ps.alive, tEmit / steps * 1e6, tUpdate / steps * 1e6, ps.evicted);
+    }
+
+    // a pickup text has to outlive a frame that refills the whole pool with rain
+    Particles_Clear(&ps);
+    Particles_AddText(&ps, (Vector2) { 0.0f, 0.0f }, WHITE, "+1");
+    Particles_Emit(&ps, &e, (Vector2) { 960.0f, 0.0f }, PARTICLE_CAP + 1);
+    Particles_Update(&ps, dt);
+    bool kept = ps.texts[0].life > 0.0f;
+    printf("text pop after a full-pool rain frame: %s\n", kept ? "kept" : "LOST");
+    Particles_Free(&ps);
+    return kept ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+// World generation: a 64x64-chunk map (32k x 32k units) planned by the caller
+// plus 0..N pool threads. The hash covers every node position, so any
+// dependence on thread count or order shows up as a changed hash.
+int Bench_WorldGen(void) {
+    const int side = 64, count = side * side;
+    ChunkPlan* plans = MemAlloc(count * sizeof(ChunkPlan));
+    GenWorld gw = { .seed = 1234u };
+
+    // at least four helpers, so the hash check means something on small machines too
+    int maxHelpers = Thread_CoreCount() - 1;
+    if (maxHelpers < 4) maxHelpers = 4;
+    printf("%-8s %10s %12s %8s %8s %8s %10s\n", "helpers", "ms", "chunks/s", "berries", "sticks", "ponds", "hash");
+    for (int helpers = 0; helpers <= maxHelpers; helpers = helpers ? helpers * 2 : 1) {
+        WorkerPool* pool = helpers ? WorkerPool_Create(helpers) : NULL;
+        for (int i = 0; i < count; i++) { plans[i].cx = i % side - side / 2; plans[i].cy = i / side - side / 2; }
+
+        double t0 = Timer_Now();
+        Gen_PlanChunks(&gw, plans, count, pool);
+        double ms = (Timer_Now() - t0) * 1e3;
+        WorkerPool_Destroy(pool);
+
+        unsigned h = 2166136261u;
+        int n[NODE_TYPE_COUNT] = { 0 };
+        for (int i = 0; i < count; i++) {
+            for (int t = 0; t < NODE_TYPE_COUNT; t++) {
+                n[t] += plans[i].count[t];
+                const unsigned char* b = (const unsigned char*)plans[i].pos[t];
+                for (int k = 0; k < plans[i].count[t] * (int)sizeof(Vector2); k++) h = (h ^ b[k]) * 16777619u;
+            }
+        }
+        printf("%-8d %10.1f %12.0f %8d %8d %8d %10x\n", helpers, ms, count / (ms * 1e-3),
+            n[NODE_BERRY], n[NODE_STICK], n[NODE_POND], h);
+    }
+    MemFree(plans);
+    return 0;
+}
@@ -0,0 +1,13 @@
+#ifndef BENCH_H
+#define BENCH_H
+#pragma once
+
+// Offline micro-benchmarks, run from the command line before any window opens:
+//   Survivor's_Oath --bench-nodes | --bench-flow | --bench-light | --bench-particles | --bench-worldgen
+int Bench_Nodes(void);   // AoS Node[] vs paged SoA NodeStore at 256 / 10k / 1M nodes
+int Bench_Flow(void);    // flow-field rebuild and per-agent lookup on 4000x3000, per cell size
+int Bench_Light(void);   // CPU lightmap build at 1920x1080 for 1..64 lights, with and without occluders
+int Bench_Particles(void); // particle pool emit + update at 1k..32k live particles
+int Bench_WorldGen(void);  // plan 64x64 chunks on 0..N helper threads; output hash must not change
+
+#endif
@@ -0,0 +1,201 @@
+#include "collide.h"
+#include "raylib.h"
+#include <math.h>
+#include <string.h>
+
+void Collider_Init(Collider* c) { *c = (Collider){ 0 }; }
+
+void Collider_Free(Collider* c) {
+    MemFree(c->x); MemFree(c->y); MemFree(c->r); MemFree(c->invMass);
+    MemFree(c->sx); MemFree(c->sy); MemFree(c->sr);
+    MemFree(c->start); MemFree(c->entryItem); MemFree(c->entryBucket); MemFree(c->entryCx); MemFree(c->entryCy);
+    MemFree(c->sorted); MemFree(c->sortedCx); MemFree(c->sortedCy);
+    *c = (Collider){ 0 };
+}
+
+void Collider_Begin(Collider* c) {
+    c->count = 0;
+    c->staticCount = 0;
+}
+
+int Collider_AddBody(Collider* c, Vector2 pos, float radius, float invMass) {
+    if (c->count == c->capacity) {
+        int cap = c->capacity ? c->capacity * 2 : 256;
+        c->x = MemRealloc(c->x, cap * sizeof(float));
+        c->y = MemRealloc(c->y, cap * sizeof(float));
+        c->r = MemRealloc(c->r, cap * sizeof(float));
+        c->invMass = MemRealloc(c->invMass, cap * sizeof(float));
+        c->capacity = cap;
+    }
+    int i = c->count++;
+    c->x[i] = pos.x;
+    c->y[i] = pos.y;
+    c->r[i] = radius;
+    c->invMass[i] = invMass;
+    return i;
+}
+
+void Collider_AddStatic(Collider* c, Vector2 pos, float radius) {
+    if (c->staticCount == c->staticCapacity) {
+        int cap = c->staticCapacity ? c->staticCapacity * 2 : 32;
+        c->sx = MemRealloc(c->sx, cap * sizeof(float));
+        c->sy = MemRealloc(c->sy, cap * sizeof(float));
+        c->sr = MemRealloc(c->sr, cap * sizeof(float));
+        c->staticCapacity = cap;
+    }
+    int i = c->staticCount++;
+    c->sx[i] = pos.x;
+    c->sy[i] = pos.y;
+    c->sr[i] = radius;
+}
+
+// -----------------------------------------------------------------------------
+// Uniform grid folded onto a power-of-two table (cells wrap around like a
+// torus), so any extent of world fits and neighbouring cells stay neighbours
+// in memory. Bodies go in the cell holding their centre; statics go in every
+// cell within half a cell of their circle, so a body only has to test the
+// statics filed under its own cell. Each entry keeps its cell, since cells a
+// table width apart share a bucket.
+static int CellOf(float v) { return (int)floorf(v * (1.0f / COLLIDE_CELL)); }
+
+static int BucketOf(const Collider* c, int cx, int cy) {
+    return (cx & c->gridMask) | ((cy & c->gridMask) << c->gridShift);
+}
+
+static void PushEntry(Collider* c, int item, int cx, int cy) {
+    if (c->entryCount == c->entryCapacity) {
+        int cap = c->entryCapacity ? c->entryCapacity * 2 : 512;
+        c->entryItem = MemRealloc(c->entryItem, cap * sizeof(int));
+        c->entryBucket = MemRealloc(c->entryBucket, cap * sizeof(int));
+        c->entryCx = MemRealloc(c->entryCx, cap * sizeof(int));
+        c->entryCy = MemRealloc(c->entryCy, cap * sizeof(int));
+        c->sorted = MemRealloc(c->sorted, cap * sizeof(int));
+        c->sortedCx = MemRealloc(c->sortedCx, cap * sizeof(int));
+        c->sortedCy = MemRealloc(c->sortedCy, cap * sizeof(int));
+        c->entryCapacity = cap;
+    }
+    int e = c->entryCount++;
+    c->entryItem[e] = item;
+    c->entryBucket[e] = BucketOf(c, cx, cy);
+    c->entryCx[e] = cx;
+    c->entryCy[e] = cy;
+}
+
+static void BuildGrid(Collider* c) {
+    // size the table from an upper bound on the entries first, so bucket ids stay valid
+    const float pad = 0.5f * COLLIDE_CELL;   // largest body radius
+    int estimate = c->count;
+    for (int s = 0; s < c->staticCount; s++) {
+        int span = (int)(2.0f * (c->sr[s] + pad) / COLLIDE_CELL) + 2;
+        estimate += span * span;
+    }
+    int shift = 3;
+    while ((1 << (2 * shift)) < estimate) shift++;
+    int buckets = 1 << (2 * shift);
+    if (buckets != c->bucketCount) {
+        c->start = MemRealloc(c->start, (buckets + 1) * sizeof(int));
+        c->bucketCount = buckets;
+    }
+    c->gridShift = shift;
+    c->gridMask = (1 << shift) - 1;
+
+    c->entryCount = 0;
+    for (int i = 0; i < c->count; i++) PushEntry(c, i, CellOf(c->x[i]), CellOf(c->y[i]));
+    for (int s = 0; s < c->staticCount; s++) {
+        float reach = c->sr[s] + pad;
+        int cx0 = CellOf(c->sx[s] - reach), cx1 = CellOf(c->sx[s] + reach);
+        int cy0 = CellOf(c->sy[s] - reach), cy1 = CellOf(c->sy[s] + reach);
+        for (int cy = cy0; cy <= cy1; cy++)
+            for (int cx = cx0; cx <= cx1; cx++) PushEntry(c, -s - 1, cx, cy);
+    }
+
+    // counting sort by bucket (stable, so the solve order is deterministic)
+    memset(c->start, 0, (buckets + 1) * sizeof(int));
+    for (int e = 0; e < c->entryCount; e++) c->start[c->entryBucket[e]]++;
+    for (int b = 1; b < buckets; b++) c->start[b] += c->start[b - 1];
+    for (int e = c->entryCount - 1; e >= 0; e--) {
+        int to = --c->start[c->entryBucket[e]];
+        c->sorted[to] = c->entryItem[e];
+        c->sortedCx[to] = c->entryCx[e];
+        c->sortedCy[to] = c->entryCy[e];
+    }
+    c->start[buckets] = c->entryCount;
+}
+
+// -----------------------------------------------------------------------------
+static void SeparatePair(Collider* c, int i, int j) {
+    float dx = c->x[j] - c->x[i], dy = c->y[j] - c->y[i];
+    float rr = c->r[i] + c->r[j];
+    float d2 = dx * dx + dy * dy;
+    c->pairsTested++;
+    if (d2 >= rr * rr) return;
+
+    float w = c->invMass[i] + c->invMass[j];
+    if (w <= 0.0f) return;
+
+    float d = sqrtf(d2), nx = 1.0f, ny = 0.0f;   // coincident: split along x
+    if (d > 1e-4f) { nx = dx / d; ny = dy / d; }
+    else d = 0.0f;
+    float push = (rr - d) / w;
+    c->x[i] -= nx * push * c->invMass[i];
+    c->y[i] -= ny * push * c->invMass[i];
+    c->x[j] += nx * push * c->invMass[j];
+    c->y[j] += ny * push * c->invMass[j];
+    c->contacts++;
+}
+
+static void PushOut(Collider* c, int i, int s) {
+    float dx = c->x[i] - c->sx[s], dy = c->y[i] - c->sy[s];
+    float rr = c->sr[s] + c->r[i];
+    float d2 = dx * dx + dy * dy;
+    c->pairsTested++;
+    if (d2 >= rr * rr) return;
+
+    float d = sqrtf(d2), nx = 1.0f, ny = 0.0f;
+    if (d > 1e-4f) { nx = dx / d; ny = dy / d; }
+    c->x[i] = c->sx[s] + nx * rr;
+    c->y[i] = c->sy[s] + ny * rr;
+    c->contacts++;
+}
+
+// Bodies in cell (cx, cy) of bucket b against body i
+static void SeparateCell(Collider* c, int i, int b, int cx, int cy) {
+    for (int e = c->start[b]; e < c->start[b + 1]; e++) {
+        int j = c->sorted[e];
+        if (j >= 0 && c->sortedCx[e] == cx && c->sortedCy[e] == cy) SeparatePair(c, i, j);
+    }
+}
+
+void Collider_Solve(Collider* c) {
+    c->pairsTested = 0;
+    c->contacts = 0;
+    if (c->count == 0) return;
+
+    // Walk the table row by row. Each body meets the bodies after it in
+    // its own cell and everything in four forward neighbours, so every pair is
+    // visited exactly once without per-pair index checks.
+    static const int fwd[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+    for (int pass = 0; pass < COLLIDE_PASSES; pass++) {
+        BuildGrid(c);
+
+        for (int b = 0; b < c->bucketCount; b++) {
+            int end = c->start[b + 1];
+            for (int e = c->start[b]; e < end; e++) {
+                int i = c->sorted[e];
+                if (i < 0) continue;
+                int cx = c->sortedCx[e], cy = c->sortedCy[e];
+
+                for (int f = c->start[b]; f < end; f++) {
+                    if (c->sortedCx[f] != cx || c->sortedCy[f] != cy) continue;   // another cell in this bucket
+                    int j = c->sorted[f];
+                    if (j < 0) PushOut(c, i, -j - 1);
+                    else if (f > e) SeparatePair(c, i, j);
+                }
+                for (int k = 0; k < 4; k++) {
+                    int nx = cx + fwd[k][0], ny = cy + fwd[k][1];
+                    SeparateCell(c, i, BucketOf(c, nx, ny), nx, ny);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef COLLIDE_H
+#define COLLIDE_H
+#include "raylib.h"
+#include <stdbool.h>
+#pragma once
+
+// Circle collision for everything that moves. Each tick the owner adds the
+// moving bodies and nearby static obstacles, then Collider_Solve separates
+// overlapping bodies and pushes bodies out of obstacles. Candidate pairs come
+// from a uniform grid rebuilt every pass (counting sort, O(n)), so the
+// cost stays near-linear in crowd size.
+#define COLLIDE_CELL   32.0f   // grid cell; must be >= the largest body diameter
+#define COLLIDE_PASSES 2       // relaxation passes per tick
+
+typedef struct Collider {
+    // moving bodies (SoA), valid from Collider_Begin to the next Begin
+    float* x; float* y;
+    float* r;
+    float* invMass;            // 0 = immovable by other bodies
+    int    count, capacity;
+
+    // static circles (obstacles)
+    float* sx; float* sy; float* sr;
+    int    staticCount, staticCapacity;
+
+    // wrapped grid: entries sorted by bucket, start[b]..start[b+1] per bucket
+    int*   start;              // bucketCount + 1
+    int*   entryItem;          // body index, or -(static index) - 1
+    int*   entryBucket;        // scratch for the sort
+    int*   entryCx; int* entryCy;
+    int*   sorted;             // entryItem in bucket order
+    int*   sortedCx; int* sortedCy;   // cell of each sorted entry
+    int    entryCount, entryCapacity;
+    int    bucketCount;        // (1 << gridShift)^2, >= entries
+    int    gridShift, gridMask;
+
+    // stats for the last Collider_Solve
+    int    pairsTested;
+    int    contacts;
+} Collider;
+
+void Collider_Init(Collider* c);
+void Collider_Free(Collider* c);
+
+void Collider_Begin(Collider* c);
+int  Collider_AddBody(Collider* c, Vector2 pos, float radius, float invMass);   // returns the body index
+void Collider_AddStatic(Collider* c, Vector2 pos, float radius);
+void Collider_Solve(Collider* c);
+
+#endif
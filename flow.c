@@ -0,0 +1,207 @@
+#include "flow.h"
+#include "raylib.h"
+#include "profile.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// neighbour steps: 0..3 orthogonal, 4..7 diagonal. Costs 2 and 3 approximate
+// 1 : sqrt(2), small enough for Dial's bucket queue (4 buckets cover them).
+static const int   kDX[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+static const int   kDY[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+static const Vector2 kDirVec[8] = {
+    { 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f },
+    { 0.70710678f, 0.70710678f }, { -0.70710678f, 0.70710678f },
+    { 0.70710678f, -0.70710678f }, { -0.70710678f, -0.70710678f },
+};
+#define STEP_COST(k) ((k) < 4 ? 2u : 3u)
+
+// Grids carry a one-cell blocked border (stride w + 2), so neighbour steps
+// never need bounds checks.
+static int Stride(const FlowField* f) { return f->w + 2; }
+static int Index(const FlowField* f, int cx, int cy) { return (cy + 1) * Stride(f) + cx + 1; }
+
+void Flow_Init(FlowField* f, float cell, int w, int h) {
+    *f = (FlowField){ .cell = cell, .invCell = 1.0f / cell, .w = w, .h = h };
+    int n = (w + 2) * (h + 2);
+    f->blocked = MemAlloc(n);
+    f->cost = MemAlloc(n * sizeof(unsigned));
+    f->dir = MemAlloc(n);
+    f->queue = MemAlloc(4 * n * sizeof(int));
+    memset(f->blocked, 1, (size_t)n);   // the border stays blocked; the window is rasterised on build
+}
+
+void Flow_Free(FlowField* f) {
+    MemFree(f->blocked);
+    MemFree(f->cost);
+    MemFree(f->dir);
+    MemFree(f->queue);
+    *f = (FlowField){ 0 };
+}
+
+static int CellOf(const FlowField* f, float v) { return (int)floorf(v * f->invCell); }
+
+// ponds over window cells [rx0, rx1) x [ry0, ry1), walked per page and
+// skipping pages whose bounds miss the rect
+static void RasterObstacles(FlowField* f, const NodeStore* nodes, int rx0, int ry0, int rx1, int ry1) {
+    if (rx0 >= rx1 || ry0 >= ry1) return;
+    for (int cy = ry0; cy < ry1; cy++) memset(f->blocked + Index(f, rx0, cy), 0, (size_t)(rx1 - rx0));
+
+    const float r = NODE_POND_SOLID;   // cells whose centre is inside a pond
+    const float x0 = (f->originX + rx0) * f->cell, y0 = (f->originY + ry0) * f->cell;
+    const float x1 = (f->originX + rx1) * f->cell, y1 = (f->originY + ry1) * f->cell;
+
+    for (int pg = nodes->firstPage[NODE_POND]; pg >= 0; pg = nodes->pages[pg]->nextOfType) {
+        const NodePage* page = nodes->pages[pg];
+        const Rectangle b = page->bounds;
+        if (page->count == 0 || b.x - r > x1 || b.x + b.width + r < x0 || b.y - r > y1 || b.y + b.height + r < y0) continue;
+
+        for (int i = 0; i < page->count; i++) {
+            Vector2 p = page->pos[i];
+            int cx0 = CellOf(f, p.x - r) - f->originX, cx1 = CellOf(f, p.x + r) - f->originX;
+            int cy0 = CellOf(f, p.y - r) - f->originY, cy1 = CellOf(f, p.y + r) - f->originY;
+            if (cx0 < rx0) cx0 = rx0;
+            if (cy0 < ry0) cy0 = ry0;
+            if (cx1 >= rx1) cx1 = rx1 - 1;
+            if (cy1 >= ry1) cy1 = ry1 - 1;
+            for (int cy = cy0; cy <= cy1; cy++) {
+                float dy = (f->originY + cy + 0.5f) * f->cell - p.y;
+                for (int cx = cx0; cx <= cx1; cx++) {
+                    float dx = (f->originX + cx + 0.5f) * f->cell - p.x;
+                    if (dx * dx + dy * dy <= r * r) f->blocked[Index(f, cx, cy)] = 1;
+                }
+            }
+        }
+    }
+}
+
+// Dial's algorithm: buckets indexed by cost mod 4. A bucket is never pushed
+// to while it drains (steps cost 2 or 3), and each cell enters a given cost
+// at most once, so each bucket needs at most one slot per cell.
+// Directions come out of the same pass: a cell points back along the step
+// that gave it its cost; among equal-cost steps the one facing the target
+// most directly wins, which keeps open-ground paths straight.
+static void Integrate(FlowField* f, int goal) {
+    static const unsigned char kOpposite[8] = { 1, 0, 3, 2, 7, 6, 5, 4 };
+    const int stride = Stride(f);
+    const int n = stride * (f->h + 2);
+    const int gx = goal % stride, gy = goal / stride;
+    int step[8];
+    for (int k = 0; k < 8; k++) step[k] = kDY[k] * stride + kDX[k];
+
+    for (int i = 0; i < n; i++) f->cost[i] = FLOW_UNREACHED;
+    memset(f->dir, FLOW_NO_DIR, (size_t)n);
+
+    int* bucket[4] = { f->queue, f->queue + n, f->queue + 2 * n, f->queue + 3 * n };
+    int  len[4] = { 0 };
+    int  pending = 1;
+    f->cost[goal] = 0;
+    f->dir[goal] = FLOW_AT_TARGET;
+    bucket[0][len[0]++] = goal;
+
+    for (unsigned d = 0; pending > 0; d++) {
+        int* q = bucket[d & 3];
+        for (int i = 0; i < len[d & 3]; i++) {
+            int c = q[i];
+            pending--;
+            if (f->cost[c] != d) continue;   // stale entry, improved since
+            for (int k = 0; k < 8; k++) {
+                int nc = c + step[k];
+                if (f->blocked[nc]) continue;
+                if (k >= 4 && (f->blocked[c + kDX[k]] || f->blocked[c + kDY[k] * stride])) continue;   // no corner cutting
+
+                unsigned nd = d + STEP_COST(k);
+                int back = kOpposite[k];
+                if (nd < f->cost[nc]) {
+                    f->cost[nc] = nd;
+                    f->dir[nc] = (unsigned char)back;
+                    bucket[nd & 3][len[nd & 3]++] = nc;
+                    pending++;
+                }
+                else if (nd == f->cost[nc]) {
+                    float tdx = (float)(gx - nc % stride), tdy = (float)(gy - nc / stride);   // unnormalised: only the ordering matters
+                    const Vector2 a = kDirVec[back], b = kDirVec[f->dir[nc]];
+                    if (a.x * tdx + a.y * tdy > b.x * tdx + b.y * tdy) f->dir[nc] = (unsigned char)back;
+                }
+            }
+        }
+        len[d & 3] = 0;
+    }
+}
+
+// Moves the window origin by (dx, dy) cells, keeping the raster of the
+// overlap and rasterising only the strips that come into view.
+static void Scroll(FlowField* f, const NodeStore* nodes, int dx, int dy) {
+    const int keepW = f->w - abs(dx), keepH = f->h - abs(dy);
+    const int to = dx < 0 ? -dx : 0;   // first kept column, after the move
+    // walk rows from the side the window moves toward, so no source row is overwritten before it is read
+    for (int i = 0; i < keepH; i++) {
+        int cy = dy > 0 ? i : f->h - 1 - i;
+        memmove(f->blocked + Index(f, to, cy), f->blocked + Index(f, to + dx, cy + dy), (size_t)keepW);
+    }
+
+    f->originX += dx;
+    f->originY += dy;
+    const int ky0 = dy < 0 ? -dy : 0, ky1 = ky0 + keepH;
+    RasterObstacles(f, nodes, 0, 0, f->w, ky0);               // rows above the kept band
+    RasterObstacles(f, nodes, 0, ky1, f->w, f->h);            // rows below it
+    RasterObstacles(f, nodes, 0, ky0, to, ky1);               // columns left of it
+    RasterObstacles(f, nodes, to + keepW, ky0, f->w, ky1);    // columns right of it
+}
+
+// Integration from the target cell over the current raster.
+static void Seed(FlowField* f) {
+    int lx = f->targetX - f->originX, ly = f->targetY - f->originY;
+    if (lx < 0 || ly < 0 || lx >= f->w || ly >= f->h) {   // target outside the window: nothing leads anywhere
+        memset(f->dir, FLOW_NO_DIR, (size_t)Stride(f) * (f->h + 2));
+        return;
+    }
+    int goal = Index(f, lx, ly);
+    unsigned char wasBlocked = f->blocked[goal];
+    f->blocked[goal] = 0;   // the player may stand on a pond's edge
+    Integrate(f, goal);
+    f->blocked[goal] = wasBlocked;   // the raster outlives this target
+}
+
+void Flow_Build(FlowField* f, const NodeStore* nodes, int originX, int originY, Vector2 target) {
+    f->originX = originX;
+    f->originY = originY;
+    f->targetX = CellOf(f, target.x);
+    f->targetY = CellOf(f, target.y);
+    f->pondRevision = nodes->revision[NODE_POND];
+    f->built = true;
+    f->rebuilds++;
+
+    RasterObstacles(f, nodes, 0, 0, f->w, f->h);
+    Seed(f);
+}
+
+bool Flow_Update(FlowField* f, const NodeStore* nodes, Vector2 target) {
+    int tx = CellOf(f, target.x), ty = CellOf(f, target.y);
+    bool pondsSame = f->built && nodes->revision[NODE_POND] == f->pondRevision;
+    if (pondsSame && tx == f->targetX && ty == f->targetY) return false;
+
+    int dx = tx - f->w / 2 - f->originX, dy = ty - f->h / 2 - f->originY;
+    if (!pondsSame || abs(dx) >= f->w || abs(dy) >= f->h) {
+        PROF_ZONE(zone, "Flow_Build");
+        Flow_Build(f, nodes, tx - f->w / 2, ty - f->h / 2, target);
+        PROF_END(zone);
+        return true;
+    }
+    PROF_ZONE(zone, "Flow_Scroll");
+    Scroll(f, nodes, dx, dy);
+    f->targetX = tx;
+    f->targetY = ty;
+    Seed(f);
+    PROF_END(zone);
+    return true;
+}
+
+bool Flow_Direction(const FlowField* f, Vector2 pos, Vector2* out) {
+    int cx = CellOf(f, pos.x) - f->originX, cy = CellOf(f, pos.y) - f->originY;
+    if (!f->built || cx < 0 || cy < 0 || cx >= f->w || cy >= f->h) return false;
+    int d = f->dir[Index(f, cx, cy)];
+    if (d >= 8) return false;
+    *out = kDirVec[d];
+    return true;
+}
@@ -0,0 +1,51 @@
+#ifndef FLOW_H
+#define FLOW_H
+#include "raylib.h"
+#include "nodes.h"
+#include <stdbool.h>
+#pragma once
+
+// Flow field toward one target (the player). One Dial's-algorithm pass over a
+// window of grid cells around the target gives every cell its path cost to
+// the target (integration field) and the neighbour to step to (direction
+// field). It is redone only when the target changes cell or a pond comes or
+// goes; any number of agents then steer with one array read each. A move of a
+// few cells scrolls the obstacle raster and fills in just the exposed strips,
+// so only the integration starts over.
+#define FLOW_CELL         32.0f                  // world units per cell
+#define FLOW_WINDOW       160                    // cells per side (5120 units around the target)
+
+#define FLOW_UNREACHED    0xFFFFFFFFu
+#define FLOW_AT_TARGET    8                      // dir value: the target's own cell
+#define FLOW_NO_DIR       255                    // dir value: blocked or unreachable
+
+typedef struct FlowField {
+    float          cell, invCell;
+    int            w, h;             // window size in cells
+    int            originX, originY; // world cell of window cell (0, 0)
+    int            targetX, targetY; // world cell the field leads to
+    unsigned       pondRevision;     // NodeStore.revision[NODE_POND] the obstacles came from
+    bool           built;
+    // grids are (w + 2) x (h + 2): the window plus a blocked border
+    unsigned char* blocked;
+    unsigned*      cost;             // integration field, FLOW_UNREACHED if cut off
+    unsigned char* dir;              // direction field: 0..7, FLOW_AT_TARGET or FLOW_NO_DIR
+    int*           queue;            // Dial's buckets, 4 x the grid
+    int            rebuilds;         // stats
+} FlowField;
+
+void Flow_Init(FlowField* f, float cell, int w, int h);
+void Flow_Free(FlowField* f);
+
+// Recentre the window on the target if it moved to another cell, or rebuild
+// it if the ponds changed. Returns true when the field changed.
+bool Flow_Update(FlowField* f, const NodeStore* nodes, Vector2 target);
+
+// Rebuild unconditionally with an explicit window origin (world cells).
+void Flow_Build(FlowField* f, const NodeStore* nodes, int originX, int originY, Vector2 target);
+
+// Unit step direction at pos. False outside the window, in the target's cell
+// or where the target can't be reached; callers then head straight for it.
+bool Flow_Direction(const FlowField* f, Vector2 pos, Vector2* out);
+
+#endif
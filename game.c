@@ -6,18 +6,26 @@
 #include "assets.h"
 #include "world.h"
 #include "ui.h"
+#include "replay.h"
+#include "audio.h"
+#include "timer.h"
+#include "profile.h"
 #include <stdlib.h>
-#include <time.h>
 #include <math.h>
 #include <string.h>
 
-static void Game_SpawnNodes(Game* g);
+static void Game_StreamWorld(Game* g);
+
+static SimPose CapturePose(const Game* g) {
+    return (SimPose) { g->cam, g->player->pos };
+}
 
 static void CamFollow(Game* g, float dt)
 {
+    PROF_ZONE(zone, "CamFollow");
     // --- Smooth follow toward player position ---
     float k = 8.0f; // smoothing factor
-    float s = 1.0f - expf(-k * GetFrameTime());
+    float s = 1.0f - expf(-k * dt);
 
     // offset camera target to center on scaled player
     Vector2 target = (Vector2){
@@ -26,35 +34,74 @@ static void CamFollow(Game* g, float dt)
     };
 
     g->cam.target = Vector2Lerp(g->cam.target, target, s);
-    g->cam.offset = (Vector2){ GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f };
+    g->cam.offset = (Vector2){ g->input.screenW / 2.0f, g->input.screenH / 2.0f };
     g->cam.zoom = 1.2f;  // keep your preferred zoom level
+    PROF_END(zone);
 }
 
 
 
+// Effect templates, in world units and seconds
+static const ParticleEmitter kFx[FX_COUNT] = {
+    [FX_SPARKLE] = { .kind = PARTICLE_SPARK, .life = 0.5f, .lifeJitter = 0.2f, .speed = 90.0f, .speedJitter = 50.0f,
+                     .spread = PI, .gravity = 120.0f, .size = 4.0f, .area = { 6.0f, 6.0f } },
+    [FX_BLOOD]   = { .kind = PARTICLE_BLOOD, .life = 0.7f, .lifeJitter = 0.25f, .speed = 140.0f, .speedJitter = 80.0f,
+                     .angle = -PI / 2.0f, .spread = PI * 0.8f, .gravity = 520.0f, .size = 3.0f, .area = { 4.0f, 4.0f } },
+};
+static const ParticleEmitter kDust = {
+    .kind = PARTICLE_DUST, .color = { 150, 130, 100, 120 }, .rate = 40.0f, .life = 0.6f, .lifeJitter = 0.2f,
+    .speed = 18.0f, .speedJitter = 10.0f, .angle = -PI / 2.0f, .spread = PI, .size = 5.0f, .area = { 8.0f, 3.0f },
+};
+static const ParticleEmitter kRain = {   // rate and area follow the view each tick
+    .kind = PARTICLE_RAIN, .color = { 170, 190, 230, 140 }, .speed = 760.0f, .speedJitter = 60.0f,
+    .angle = PI * 0.56f, .spread = 0.03f, .size = 1.5f,
+};
+
+void Game_Burst(Game* g, GameFx fx, Vector2 worldPos, Color tint, int count) {
+    ParticleEmitter e = kFx[fx];
+    e.color = tint;
+    Particles_Emit(&g->particles, &e, worldPos, count);
+}
+
 void Game_AddPop(Game* g, Vector2 worldPos, Color color, const char* msg) {
-    if (g->popCount >= MAX_POPS) {
-        g->pops[0] = g->pops[g->popCount - 1];
-        g->popCount--;
+    Particles_AddText(&g->particles, worldPos, color, msg);
+    Game_Burst(g, FX_SPARKLE, worldPos, color, 14);
+}
+
+// Particles for one tick: the continuous emitters (dust behind a sprinting
+// player, rain across the whole view at night), then the pool itself.
+static void UpdateEffects(Game* g, float dt) {
+    const Player* p = g->player;
+    if (Input_Down(&g->input, BTN_SPRINT) && Vector2LengthSqr(p->vel) > 100.0f * 100.0f)
+        Particles_RunEmitter(&g->particles, &g->dust, (Vector2) { p->pos.x, p->pos.y + 10.0f * p->scale }, dt);
+
+    if (Game_IsNight(g) > 0.0f) {
+        Rectangle v = Game_ViewRect(g);
+        g->rain.rate = v.width * 6.0f;                    // drops per second per world unit of width
+        g->rain.life = (v.height + 120.0f) / kRain.speed; // long enough to cross the view
+        g->rain.area = (Vector2){ v.width * 0.6f, 40.0f };
+        Particles_RunEmitter(&g->particles, &g->rain, (Vector2) { v.x + v.width * 0.55f, v.y - 60.0f }, dt);   // upwind: drops drift left
     }
-    PopFX* p = &g->pops[g->popCount++];
-    p->pos = worldPos;
-    p->t = 0.0f;
-    p->color = color;
-
-#if defined(_MSC_VER)
-    strncpy_s(p->msg, sizeof(p->msg), msg, _TRUNCATE);  // MSVC-safe
-#else
-    snprintf(p->msg, sizeof(p->msg), "%s", msg);
-#endif
+    Particles_Update(&g->particles, dt);
+}
+
+// xorshift32; the whole session follows from the seed passed to Game_Init
+unsigned Game_Rand(Game* g) {
+    unsigned x = g->rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return g->rng = x;
 }
 
-void Game_Init(Game* g, Assets* assets) {
-    srand((unsigned)time(NULL));
+void Game_Init(Game* g, Assets* assets, unsigned seed) {
+    g->rng = seed ? seed : 0x9E3779B9u;
+    g->simTime = 0.0;
+    g->autosave.nextAt = AUTOSAVE_INTERVAL;
     g->assets = assets;
 
     // general gameplay resets
-    g->popCount = 0;
+    Particles_Init(&g->particles, g->rng ^ 0xA5A5A5A5u);   // its own stream: effects never shift gameplay randomness
+    g->rain = kRain;
+    g->dust = kDust;
     g->lightRadius = 180.0f;
     g->hitFlash = 0.0f;
     g->shakeTime = 0.0f;
@@ -74,12 +121,37 @@ void Game_Init(Game* g, Assets* assets) {
     g->totalCluesRequired = 4;
 
     // world + camera
+    Vector2 spawn = (Vector2){ HOME_W / 2.0f, HOME_H / 2.0f };
     g->cam = (Camera2D){ 0 };
     g->cam.zoom = 2.0f;
-    Game_SpawnNodes(g);
+    g->cam.target = spawn;
+    g->cam.offset = (Vector2){ g->input.screenW / 2.0f, g->input.screenH / 2.0f };
+
+    Nodes_Init(&g->nodes);
+    g->nearNode = NODE_NONE;
+    g->world = World_Create(Game_Rand(g), CHUNK_BUDGET, g->workers);
+    Game_StreamWorld(g);
+
+    g->player = Player_Create(spawn);
+
+    // the story rival, plus a ring of extras in horde mode
+    Flow_Init(&g->flow, FLOW_CELL, FLOW_WINDOW, FLOW_WINDOW);
+    Collider_Init(&g->collider);
+    Lightmap_Init(&g->light);
+    Minimap_Init(&g->map);
+    Rivals_Init(&g->rivals);
+    Rivals_Spawn(&g->rivals, (Vector2) { 300, 300 }, RIVAL_SCALE);
+    for (int i = 1; i < g->hordeSize; i++) {
+        float ang = (Game_Rand(g) & 0xFFFF) * (2.0f * PI / 65536.0f);
+        float dist = 900.0f + (float)(Game_Rand(g) % 3000);
+        Rivals_Spawn(&g->rivals, (Vector2) { spawn.x + cosf(ang) * dist, spawn.y + sinf(ang) * dist }, RIVAL_SCALE);
+    }
 
-    g->player = Player_Create((Vector2) { WORLD_W / 2.0f, WORLD_H / 2.0f });
-    g->rival = Rival_Create((Vector2) { 300, 300 });
+    // nothing to interpolate from yet
+    g->simAccum = 0.0;
+    g->simAlpha = 0.0f;
+    g->prevPose = CapturePose(g);
+    g->pose = g->prevPose;
 
     // time cycle
     g->timeOfDay = 0.20f;
@@ -92,20 +164,25 @@ void Game_Init(Game* g, Assets* assets) {
     float night = Game_IsNight(g);
     g->musicDayVol = (1.0f - night) * 0.8f;
     g->musicNightVol = night * 0.6f;
-
-    if (g->assets->bgDay.ctxData) {
-        PlayMusicStream(g->assets->bgDay);
-        SetMusicVolume(g->assets->bgDay, g->musicDayVol);
-    }
-    if (g->assets->bgNight.ctxData) {
-        PlayMusicStream(g->assets->bgNight);
-        SetMusicVolume(g->assets->bgNight, g->musicNightVol);
-    }
+    Audio_StartMusic(g->musicDayVol, g->musicNightVol);
 }
 
 void Game_Shutdown(Game* g) {
+    Autosave_Wait(&g->autosave);   // let a save in flight reach the disk
     Player_Destroy(g->player);
-    Rival_Destroy(g->rival);
+    Rivals_Free(&g->rivals);
+    Flow_Free(&g->flow);
+    Collider_Free(&g->collider);
+    Lightmap_Free(&g->light);
+    PostFx_Free(&g->post);
+    Minimap_Free(&g->map);
+    Particles_Free(&g->particles);
+    World_Destroy(g->world, &g->nodes);
+    Nodes_Free(&g->nodes);
+}
+
+bool Game_CanStart(const Game* g) {
+    return !g->assets || g->assets->spritesReady;   // headless runs have no assets at all
 }
 
 float Game_IsNight(const Game* g) {
@@ -114,19 +191,156 @@ float Game_IsNight(const Game* g) {
 
 static void HandleGlobalShortcuts(Game* g) {
     if (IsKeyPressed(KEY_GRAVE)) g->quitRequested = true; // tilde = quick exit (dev)
+    if (IsKeyPressed(KEY_F3)) g->showStats = !g->showStats; // perf overlay (dev)
+    if (IsKeyPressed(KEY_F4)) Prof_Trigger();                // dump the last second as a Chrome trace (dev)
+}
+
+// World rectangle covered by a camera on a w x h screen (any zoom, no rotation)
+static Rectangle CameraView(Camera2D cam, float w, float h) {
+    float zoom = (cam.zoom > 0.0f) ? cam.zoom : 1.0f;
+    return (Rectangle) {
+        cam.target.x - cam.offset.x / zoom,
+        cam.target.y - cam.offset.y / zoom,
+        w / zoom,
+        h / zoom
+    };
 }
 
-void Game_SpawnNodes(Game* g) {
-    g->nodeCount = 0;
-    World_SpawnScatter(g->nodes, &g->nodeCount, MAX_NODES, NODE_BERRY, 22);
-    World_SpawnScatter(g->nodes, &g->nodeCount, MAX_NODES, NODE_POND, 6);
-    World_SpawnScatter(g->nodes, &g->nodeCount, MAX_NODES, NODE_STICK, 18);
-    World_SpawnScatter(g->nodes, &g->nodeCount, MAX_NODES, NODE_CLUE, 4);
+// simulation view: sized from the tick's input so streaming replays exactly
+Rectangle Game_ViewRect(const Game* g) { return CameraView(g->cam, (float)g->input.screenW, (float)g->input.screenH); }
+
+static unsigned HashBytes(unsigned h, const void* p, size_t n) {
+    const unsigned char* b = p;
+    for (size_t i = 0; i < n; i++) h = (h ^ b[i]) * 16777619u;   // FNV-1a
+    return h;
 }
 
-void Game_Update(Game* g, float dt) {
+unsigned Game_Checksum(const Game* g) {
+    unsigned h = 2166136261u;
+    h = HashBytes(h, &g->state, sizeof(g->state));
+    h = HashBytes(h, &g->rng, sizeof(g->rng));
+    h = HashBytes(h, &g->timeOfDay, sizeof(g->timeOfDay));
+    h = HashBytes(h, &g->cluesCollected, sizeof(g->cluesCollected));
+    h = HashBytes(h, &g->cam.target, sizeof(g->cam.target));
+    h = HashBytes(h, &g->cam.zoom, sizeof(g->cam.zoom));
+    h = HashBytes(h, &g->nodes.count, sizeof(g->nodes.count));
+    if (g->player) {
+        const Player* p = g->player;
+        h = HashBytes(h, &p->pos, sizeof(p->pos));
+        h = HashBytes(h, &p->vel, sizeof(p->vel));
+        h = HashBytes(h, &p->hp, sizeof(p->hp));
+        h = HashBytes(h, &p->hunger, sizeof(p->hunger));
+        h = HashBytes(h, &p->thirst, sizeof(p->thirst));
+        h = HashBytes(h, &p->invFood, sizeof(p->invFood));
+        h = HashBytes(h, &p->invWater, sizeof(p->invWater));
+        h = HashBytes(h, &p->invStick, sizeof(p->invStick));
+    }
+    const RivalPool* rp = &g->rivals;
+    h = HashBytes(h, &rp->count, sizeof(rp->count));
+    if (rp->count > 0) {
+        h = HashBytes(h, rp->x, rp->count * sizeof(float));
+        h = HashBytes(h, rp->y, rp->count * sizeof(float));
+        h = HashBytes(h, rp->hitTimer, rp->count * sizeof(float));
+    }
+    return h;
+}
+
+// Player and rivals are circles: separate them from each other and push them
+// out of ponds. Only ponds near the crowd's bounds are handed to the solver.
+static void ResolveCollisions(Game* g) {
+    PROF_ZONE(zone, "ResolveCollisions");
+    Collider*  c = &g->collider;
+    RivalPool* rp = &g->rivals;
+    Player*    p = g->player;
+
+    Collider_Begin(c);
+    float x0 = p->pos.x, x1 = p->pos.x, y0 = p->pos.y, y1 = p->pos.y;
+    for (int i = 0; i < rp->count; i++) {
+        Collider_AddBody(c, Rivals_Pos(rp, i), RIVAL_RADIUS * rp->scale[i], 1.0f);
+        x0 = fminf(x0, rp->x[i]); x1 = fmaxf(x1, rp->x[i]);
+        y0 = fminf(y0, rp->y[i]); y1 = fmaxf(y1, rp->y[i]);
+    }
+    int self = Collider_AddBody(c, p->pos, p->baseRadius * p->scale, 0.25f);   // the crowd shoves the player only a little
+
+    float m = NODE_POND_SOLID + COLLIDE_CELL;
+    for (int pg = g->nodes.firstPage[NODE_POND]; pg >= 0; pg = g->nodes.pages[pg]->nextOfType) {
+        const NodePage* page = g->nodes.pages[pg];
+        Rectangle b = page->bounds;
+        if (page->count == 0 || b.x > x1 + m || b.x + b.width < x0 - m || b.y > y1 + m || b.y + b.height < y0 - m) continue;
+        for (int i = 0; i < page->count; i++) Collider_AddStatic(c, page->pos[i], NODE_POND_SOLID);
+    }
+
+    Collider_Solve(c);
+
+    for (int i = 0; i < rp->count; i++) { rp->x[i] = c->x[i]; rp->y[i] = c->y[i]; }
+    Vector2 to = { c->x[self], c->y[self] };
+    if (World_IsLoaded(g->world, to)) p->pos = to;   // never shoved into an unloaded chunk
+    PROF_END(zone);
+}
+
+// keep the chunk ring around the camera resident
+static void Game_StreamWorld(Game* g) {
+    PROF_ZONE(zone, "World_Stream");
+    World_Stream(g->world, &g->nodes, Game_ViewRect(g));
+    PROF_END(zone);
+}
+
+// Presses that would start or resume a run are dropped here, before the
+// replay log sees them, while the sprites are still loading: load timing is
+// wall-clock, so the simulation itself must never depend on it.
+static void HoldUntilLoaded(Game* g) {
+    if (Game_CanStart(g)) return;
+    Input* in = &g->input;
+    const unsigned nav = (1u << BTN_UP) | (1u << BTN_DOWN);
+    if (g->state == STATE_INTRO && !g->showHelp && (g->menuIndex == 0 || (in->pressed & nav)))
+        in->pressed &= ~((1u << BTN_CONFIRM) | (1u << BTN_ATTACK));
+    if (g->state == STATE_PAUSED)
+        in->pressed &= ~(1u << BTN_BACK);
+}
+
+// Per rendered frame: run as many fixed ticks as real time allows (at most
+// SIM_MAX_STEPS, so a hitch can't snowball), then interpolate what gets drawn.
+void Game_Frame(Game* g, float frameDt) {
+    FrameStats_Add(&g->frames, frameDt * 1000.0f);
     HandleGlobalShortcuts(g);
+    Input_Poll(&g->input);
+    HoldUntilLoaded(g);
+
+    // music is fed on its own thread; it holds still outside of play
+    Audio_SetMusicPaused(g->state != STATE_PLAYING);
+    Audio_UpdateMusic();
+
+    g->simAccum += frameDt;
+    int steps = 0;
+    while (g->simAccum >= SIM_DT && steps < SIM_MAX_STEPS) {
+        // a replay log records or supplies exactly what this tick sees
+        if (g->replay && !Replay_Tick(g->replay, &g->input)) {
+            g->quitRequested = true;   // playback finished
+            g->simAccum = 0.0;
+            break;
+        }
+        g->prevPose = CapturePose(g);
+        Game_Update(g, SIM_DT);
+        Input_Consume(&g->input);
+        g->simAccum -= SIM_DT;
+        steps++;
+    }
+    if (g->simAccum >= SIM_DT) g->simAccum = 0.0;   // over budget: drop the backlog
+
+    float t = (float)(g->simAccum / SIM_DT);
+    SimPose now = CapturePose(g);
+    g->simAlpha = t;
+    g->pose.player = Vector2Lerp(g->prevPose.player, now.player, t);
+    g->pose.cam = now.cam;
+    g->pose.cam.target = Vector2Lerp(g->prevPose.cam.target, now.cam.target, t);
+    g->pose.cam.offset = Vector2Lerp(g->prevPose.cam.offset, now.cam.offset, t);
+    g->pose.cam.zoom = Lerp(g->prevPose.cam.zoom, now.cam.zoom, t);
+}
 
+void Game_Update(Game* g, float dt) {
+    PROF_ZONE(zone, "Game_Update");
+    double tickStart = Timer_Now();
+    g->simTime += dt;
     switch (g->state) {
     case STATE_INTRO: {
         g->introTimer += dt;
@@ -137,12 +351,12 @@ void Game_Update(Game* g, float dt) {
         }
 
         if (!g->showHelp) {
-            if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W))
+            if (Input_Pressed(&g->input, BTN_UP))
                 g->menuIndex = (g->menuIndex + 2) % 3;
-            if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S))
+            if (Input_Pressed(&g->input, BTN_DOWN))
                 g->menuIndex = (g->menuIndex + 1) % 3;
 
-            if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
+            if (Input_Pressed(&g->input, BTN_CONFIRM) || Input_Pressed(&g->input, BTN_ATTACK)) {
                 if (g->menuIndex == 0) {
                     g->cluesCollected = 0;
                     g->timeOfDay = 0.20f;
@@ -162,18 +376,18 @@ void Game_Update(Game* g, float dt) {
             }
         }
         else {
-            if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_ESCAPE))
+            if (Input_Pressed(&g->input, BTN_CONFIRM) || Input_Pressed(&g->input, BTN_BACK))
                 g->showHelp = false;
         }
 
-        if (IsKeyPressed(KEY_ESCAPE) && !g->showHelp)
+        if (Input_Pressed(&g->input, BTN_BACK) && !g->showHelp)
             g->quitRequested = true;
     } break;
 
     case STATE_STORY: {
         g->storyTimer += dt;
 
-        if (IsKeyPressed(KEY_ENTER) && g->storyTimer > 0.20f) {
+        if (Input_Pressed(&g->input, BTN_CONFIRM) && g->storyTimer > 0.20f) {
             g->storyTimer = 0.0f;
             g->storyIndex++;
 
@@ -183,15 +397,11 @@ void Game_Update(Game* g, float dt) {
             }
         }
 
-        if (IsKeyPressed(KEY_ESCAPE))
+        if (Input_Pressed(&g->input, BTN_BACK))
             g->quitRequested = true;
     } break;
 
     case STATE_PLAYING: {
-        // music update
-        if (g->assets->bgDay.ctxData)   UpdateMusicStream(g->assets->bgDay);
-        if (g->assets->bgNight.ctxData) UpdateMusicStream(g->assets->bgNight);
-
         float night = Game_IsNight(g);
         float targetDay = (1.0f - night) * 0.8f;
         float targetNight = night * 0.6f;
@@ -199,8 +409,7 @@ void Game_Update(Game* g, float dt) {
         g->musicDayVol = Lerp(g->musicDayVol, targetDay, dt * 2.0f);
         g->musicNightVol = Lerp(g->musicNightVol, targetNight, dt * 2.0f);
 
-        if (g->assets->bgDay.ctxData)   SetMusicVolume(g->assets->bgDay, g->musicDayVol);
-        if (g->assets->bgNight.ctxData) SetMusicVolume(g->assets->bgNight, g->musicNightVol);
+        Audio_SetMusicVolume(g->musicDayVol, g->musicNightVol);
 
         if (g->hitFlash > 0.0f) {
             g->hitFlash -= dt * 2.0f;
@@ -236,9 +445,21 @@ void Game_Update(Game* g, float dt) {
             }
         }
 
+        double t0 = Timer_Now();
         Player_Update(g->player, g, dt);
-        Rival_Update(g->rival, g, dt);
-        if (IsKeyPressed(KEY_ESCAPE)) g->state = STATE_PAUSED;
+        double t1 = Timer_Now();
+        Flow_Update(&g->flow, &g->nodes, g->player->pos);   // no-op unless the player changed cell
+        double t2 = Timer_Now();
+        Rivals_Update(&g->rivals, g, dt);
+        double t3 = Timer_Now();
+        g->timings.player += t1 - t0;
+        g->timings.flow += t2 - t1;
+        g->timings.rival += t3 - t2;
+
+        ResolveCollisions(g);
+        g->timings.collide += Timer_Now() - t3;
+        Minimap_Reveal(&g->map, g->player->pos, g->lightRadius * g->player->scale / g->cam.zoom);   // the flashlight's reach
+        if (Input_Pressed(&g->input, BTN_BACK)) g->state = STATE_PAUSED;
         CamFollow(g, dt);
 
         // Dynamic zoom based on player size
@@ -246,6 +467,9 @@ void Game_Update(Game* g, float dt) {
         targetZoom = Clamp(targetZoom, 0.35f, 2.0f);
         float zSmooth = 1.0f - expf(-8.0f * dt);
         g->cam.zoom += (targetZoom - g->cam.zoom) * zSmooth;
+        double t4 = Timer_Now();
+        Game_StreamWorld(g);
+        g->timings.world += Timer_Now() - t4;
 
         // --- Camera shake ---
         if (g->shakeTime > 0.0f) {
@@ -254,8 +478,8 @@ void Game_Update(Game* g, float dt) {
             Vector2 desired = g->player->pos;
             g->cam.target = Vector2Lerp(g->cam.target, desired, s);
 
-            float cx = GetScreenWidth() / 2.0f;
-            float cy = GetScreenHeight() / 2.0f;
+            float cx = g->input.screenW / 2.0f;
+            float cy = g->input.screenH / 2.0f;
             g->cam.offset = (Vector2){ cx, cy };
 
             g->cam.target.x = floorf(g->cam.target.x);
@@ -263,7 +487,7 @@ void Game_Update(Game* g, float dt) {
 
             float shake = g->shakeTime;
             float amp = 4.0f * shake;
-            float timeNow = (float)GetTime();
+            float timeNow = (float)g->simTime;
             Vector2 jitter = { sinf(timeNow * 50.0f) * amp, cosf(timeNow * 45.0f) * amp };
             g->cam.offset.x += jitter.x;
             g->cam.offset.y += jitter.y;
@@ -271,34 +495,31 @@ void Game_Update(Game* g, float dt) {
             g->shakeTime = fmaxf(0.0f, g->shakeTime - 3.0f * dt);
         }
 
-        // update popups
-        for (int i = 0; i < g->popCount;) {
-            g->pops[i].t += dt;
-            if (g->pops[i].t > 0.9f) {
-                g->pops[i] = g->pops[g->popCount - 1];
-                g->popCount--;
-                continue;
-            }
-            i++;
-        }
+        UpdateEffects(g, dt);
 
         if (g->player->hp <= 0) g->state = STATE_GAMEOVER;
         if (g->cluesCollected >= 4) g->state = STATE_WIN;
+        if (g->state == STATE_PLAYING) Autosave_Update(&g->autosave, g);
+        else if (g->state != STATE_PAUSED) Autosave_Discard(&g->autosave);   // the run is over; nothing to resume
     } break;
 
     case STATE_PAUSED:
-        if (IsKeyPressed(KEY_ESCAPE)) g->state = STATE_PLAYING;
+        if (Input_Pressed(&g->input, BTN_BACK)) g->state = STATE_PLAYING;
         break;
 
     case STATE_GAMEOVER:
     case STATE_WIN:
-        if (IsKeyPressed(KEY_ENTER)) {
+        if (Input_Pressed(&g->input, BTN_CONFIRM)) {
             Game_Shutdown(g);
-            Game_Init(g, g->assets);
+            Game_Init(g, g->assets, Game_Rand(g));
             g->state = STATE_INTRO;
         }
         break;
     }
+
+    g->timings.total += Timer_Now() - tickStart;
+    g->timings.ticks++;
+    PROF_END(zone);
 }
 
 static Color SkyColor(float t) {
@@ -308,28 +529,119 @@ static Color SkyColor(float t) {
     return (Color) { 80, 110, 160, 255 };
 }
 
+// Actor (sprite + shadow + label) bounded by a circle of radius r; counts into stats.
+static bool ActorVisible(Game* g, Rectangle view, Vector2 pos, float r) {
+    bool in = pos.x + r >= view.x && pos.x - r <= view.x + view.width &&
+              pos.y + r >= view.y && pos.y - r <= view.y + view.height;
+    if (in) g->stats.actorsVisible++; else g->stats.actorsCulled++;
+    return in;
+}
+
+// Night: the flashlight, the player's own glow and every clue still lying
+// around, shadowed by ponds (the same obstacles the collider uses). Lights
+// are in screen space; the map is multiplied over the world, under the HUD.
+// False (and nothing built) by day.
+static bool BuildLighting(Game* g, Rectangle view) {
+    float night = Game_IsNight(g);
+    if (night <= 0.15f) return false;
+    PROF_ZONE(zone, "BuildLighting");
+    Lightmap* lm = &g->light;
+    Camera2D cam = g->pose.cam;
+    float zoom = cam.zoom > 0.0f ? cam.zoom : 1.0f;
+    unsigned char ambient = (unsigned char)(255.0f * (0.75f - 0.35f * night));
+    Lightmap_Begin(lm, GetScreenWidth(), GetScreenHeight(), (Color) { ambient, ambient, ambient, 255 });
+
+    float reach = 0.0f;   // furthest any light extends past the view, in world units
+    if (g->lightRadius > 0.0f) {
+        Vector2 sp = GetWorldToScreen2D(g->pose.player, cam);
+        float   R = g->lightRadius * g->player->scale;
+        Lightmap_AddCone(lm, sp, R, g->player->facing, 42.0f * DEG2RAD, (Color) { 255, 244, 220, 255 }, 0.9f);
+        Lightmap_AddPoint(lm, sp, R * 0.35f, WHITE, 0.8f);   // soft origin
+        reach = R / zoom;
+    }
+
+    const float glow = 70.0f;
+    for (int pg = g->nodes.firstPage[NODE_CLUE]; pg >= 0; pg = g->nodes.pages[pg]->nextOfType) {
+        const NodePage* page = g->nodes.pages[pg];
+        for (int i = 0; i < page->count; i++) {
+            Vector2 p = page->pos[i];
+            if (page->taken[i] || p.x + glow < view.x || p.x - glow > view.x + view.width ||
+                p.y + glow < view.y || p.y - glow > view.y + view.height) continue;
+            Lightmap_AddPoint(lm, GetWorldToScreen2D(p, cam), glow * zoom, GOLD, 0.6f);
+        }
+    }
+
+    float m = NODE_POND_SOLID + (reach > glow ? reach : glow);
+    for (int pg = g->nodes.firstPage[NODE_POND]; pg >= 0; pg = g->nodes.pages[pg]->nextOfType) {
+        const NodePage* page = g->nodes.pages[pg];
+        Rectangle b = page->bounds;
+        if (page->count == 0 || b.x > view.x + view.width + m || b.x + b.width < view.x - m ||
+            b.y > view.y + view.height + m || b.y + b.height < view.y - m) continue;
+        for (int i = 0; i < page->count; i++)
+            Lightmap_AddOccluder(lm, GetWorldToScreen2D(page->pos[i], cam), NODE_POND_SOLID * zoom);
+    }
+
+    Lightmap_Build(lm);
+    PROF_END(zone);
+    return true;
+}
+
 void Game_Draw(Game* g) {
+    PROF_ZONE(zone, "Game_Draw");
     if (g->state == STATE_INTRO) {
         ClearBackground(BLACK);
-        const char* t = "SURVIVOR'S OATH: BLOOD & BONDS";
-        DrawText(t, (GetScreenWidth() - MeasureText(t, 36)) / 2, 180, 36, RAYWHITE);
-        const char* s = "WASD move • E interact • 1 eat • 2 drink • F craft spear • SPACE attack";
-        DrawText(s, (GetScreenWidth() - MeasureText(s, 18)) / 2, 240, 18, LIGHTGRAY);
-        DrawText("Press ENTER to begin", (GetScreenWidth() - MeasureText("Press ENTER to begin", 22)) / 2, 300, 22, YELLOW);
+        UI_DrawIntro(g);   // menu, plus load progress while assets stream in
+        PROF_END(zone);
         return;
     }
 
+    // everything below is drawn from the interpolated pose and culled against it
+    int sw = GetScreenWidth(), sh = GetScreenHeight();
+    Rectangle view = CameraView(g->pose.cam, (float)sw, (float)sh);
+    g->stats = (RenderStats){ 0 };
+    World_PrepareDraw(g->world, &g->nodes, g->assets, view, &g->stats);   // render-texture work, outside Mode2D
+    Minimap_PrepareDraw(&g->map, &g->nodes);
+
+    // the world goes to the compositor's scene target when there is one
+    bool post = PostFx_Begin(&g->post, sw, sh);
     ClearBackground(SkyColor(g->timeOfDay));
-    BeginMode2D(g->cam);
 
-    World_DrawGround(g->assets);
-    World_DrawNodes(g->nodes, g->nodeCount, g->assets);
-    Rival_Draw(g->rival, g->assets);
-    Player_Draw(g->player, g->assets);
+    Assets_BeginMode2D(g->pose.cam);
+    World_Draw(g->world, &g->nodes, g->assets, view, &g->stats);
+    for (int i = 0; i < g->rivals.count; i++) {
+        Vector2 at = Rivals_DrawPos(&g->rivals, i, g->simAlpha);
+        float   scale = g->rivals.scale[i];
+        if (ActorVisible(g, view, at, 30.0f * scale)) Rival_Draw(at, scale, g->assets);
+    }
+    if (ActorVisible(g, view, g->pose.player, 30.0f * g->player->scale)) {
+        Player shown = *g->player;
+        shown.pos = g->pose.player;
+        Player_Draw(&shown, g->assets);
+    }
+    Particles_Draw(&g->particles, view, g->simAlpha, SIM_DT);
+
+    Assets_EndMode2D();
+
+    // screen-wide effects: lightmap, hit flash
+    bool  lit = BuildLighting(g, view);
+    Color flash = Fade(RED, g->hitFlash * 0.6f);
+    if (post) {
+        PostParams params = { { 0 }, { 1.0f, 1.0f }, 0.0f, flash };   // no vignette: the night fade isn't drawn
+        if (lit) {
+            params.light = Lightmap_Upload(&g->light);
+            params.lightScale = (Vector2){ sw / (float)(g->light.w * LIGHT_CELL), sh / (float)(g->light.h * LIGHT_CELL) };
+        }
+        PostFx_End(&g->post, &params);
+    }
+    else {   // the same effects, one blended pass each
+        if (lit) Lightmap_Draw(&g->light);
+        if (g->hitFlash > 0.0f) DrawRectangle(0, 0, sw, sh, flash);
+    }
 
-    EndMode2D();
+    Particles_DrawText(&g->particles, g->pose.cam, g->simAlpha, SIM_DT);   // pickup texts, over the lighting
 
-    if (g->state == STATE_PAUSED) UI_DrawPause();
+    if (g->state == STATE_PAUSED) UI_DrawPause(!Game_CanStart(g));
     if (g->state == STATE_GAMEOVER) UI_DrawCenterMessage("YOU DIED", RED, "Press ENTER to restart");
     if (g->state == STATE_WIN) UI_DrawCenterMessage("TRACKS FOUND — REUNION CLOSE", YELLOW, "Press ENTER to start a new run");
+    PROF_END(zone);
 }
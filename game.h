@@ -2,10 +2,23 @@
 #define GAME_H
 
 #include "raylib.h"
+#include "nodes.h"
+#include "input.h"
+#include "rival.h"
+#include "flow.h"
+#include "collide.h"
+#include "perf.h"
+#include "light.h"
+#include "post.h"
+#include "minimap.h"
+#include "snapshot.h"
+#include "particles.h"
 #include <stdbool.h>
 
-#define MAX_NODES  256
-#define MAX_POPS   64
+// Simulation runs in fixed ticks, decoupled from the render rate.
+#define SIM_HZ          60
+#define SIM_DT          (1.0f / SIM_HZ)
+#define SIM_MAX_STEPS   5      // catch-up ticks per frame; time beyond this is dropped
 #pragma once
 
 
@@ -18,29 +31,42 @@ typedef enum GameState {
     STATE_WIN
 } GameState;
 
-typedef enum NodeType {
-    NODE_BERRY = 0,
-    NODE_STICK,
-    NODE_POND,
-    NODE_CLUE
-} NodeType;
-
-typedef struct Node {
-    Vector2 pos;
-    NodeType type;
-    bool taken;
-} Node;
-
-typedef struct PopFX {
-    Vector2 pos;
-    float   t;
-    char    msg[16];   // <-- was text[16]; UI uses .msg
-    Color   color;     // <-- was col;     code uses .color
-} PopFX;
+// One-shot effects gameplay code can fire (Game_Burst)
+typedef enum GameFx {
+    FX_SPARKLE = 0,    // pickups, tinted per call
+    FX_BLOOD,
+    FX_COUNT
+} GameFx;
+
+// Per-frame draw culling counters (reset at the start of Game_Draw)
+typedef struct RenderStats {
+    int nodesVisible, nodesCulled;     // nodes drawn live (clues, uncached chunks)
+    int actorsVisible, actorsCulled;   // player + rivals
+    int chunksCached, chunksDirect;    // visible chunks drawn from their baked texture / live
+    int chunksBaked;                   // chunks re-baked this frame
+} RenderStats;
+
+// Wall-clock seconds spent in Game_Update, per subsystem, summed over ticks
+typedef struct SimTimings {
+    double total;
+    double player, rival;    // Player_Update / Rivals_Update
+    double flow;             // flow-field rebuilds
+    double collide;          // broadphase + separation
+    double world;            // chunk streaming
+    unsigned long long ticks;
+} SimTimings;
+
+// Everything the renderer interpolates between the last two ticks
+// (rivals keep their previous positions in the pool)
+typedef struct SimPose {
+    Camera2D cam;
+    Vector2  player;
+} SimPose;
 
 struct Player;
-struct Rival;
 struct Assets;
+struct World;
+struct Replay;
 
 typedef struct Game {
 
@@ -61,6 +87,8 @@ typedef struct Game {
 
     // --- light/shake/hit ---
     float lightRadius;
+    Lightmap light;        // night lighting, rebuilt every drawn frame
+    PostFx   post;         // one-pass compositor for the screen-wide effects
     float hitFlash;
     float shakeTime;
 
@@ -72,22 +100,44 @@ typedef struct Game {
     // --- meta ---
     GameState state;
     bool quitRequested;
+    bool showStats;        // F3: dev perf overlay
+    RenderStats stats;
+    FrameStats  frames;    // frame-time history for the overlay
+
+    // --- fixed-step simulation ---
+    Input   input;         // polled per frame; press edges wait for the next tick
+    double  simAccum;      // real time not yet simulated
+    float   simAlpha;      // 0..1 position of this frame between prevPose and now
+    SimPose prevPose;      // state before the latest tick
+    SimPose pose;          // interpolated state drawn this frame
+    double  simTime;       // seconds simulated since Game_Init
+    unsigned rng;          // gameplay RNG state (Game_Rand), seeded by Game_Init
+    struct Replay* replay; // optional input log being recorded or played back
+    Autosave autosave;     // periodic background save of the run (path set by the caller)
+    SimTimings timings;
 
     // --- goal ---
     int  totalCluesRequired;
     int  cluesCollected;
 
     // --- objects ---
-    Node  nodes[MAX_NODES];
-    int   nodeCount;
+    struct World* world;   // chunk streaming; owns the node pages below
+    WorkerPool* workers;   // helps generate chunks; set before Game_Init, NULL generates inline
+    NodeStore nodes;
+    NodeId    nearNode;    // nearest interactable node this tick, NODE_NONE if none
+    Minimap   map;         // explored area of the home region, for the HUD
 
     // --- fx ---
-    PopFX pops[MAX_POPS];
-    int   popCount;
+    Particles       particles;   // pickup texts and sparkles, blood, dust, rain
+    ParticleEmitter rain;        // night weather over the view
+    ParticleEmitter dust;        // kicked up while sprinting
 
     // --- characters/resources ---
     struct Player* player;
-    struct Rival* rival;
+    RivalPool rivals;
+    FlowField flow;        // rivals' shared path field toward the player
+    Collider  collider;    // per-tick circle collision for player + rivals
+    int       hordeSize;   // rivals Game_Init spawns (set beforehand; <= 1 = just the story rival)
     struct Assets* assets;
 
     // --- audio mix ---
@@ -96,13 +146,19 @@ typedef struct Game {
 } Game;
 
 // ---- game API used by other modules
-void Game_Init(Game* g, struct Assets* assets);
-void Game_Update(Game* g, float dt);
+void Game_Init(Game* g, struct Assets* assets, unsigned seed);
+void Game_Frame(Game* g, float frameDt);   // per rendered frame: input, fixed ticks, interpolation
+void Game_Update(Game* g, float dt);       // one simulation tick of SIM_DT
 void Game_Draw(Game* g);
 void Game_Shutdown(Game* g);
 
 // helpers used by player/ui/rival
-void Game_AddPop(Game* g, Vector2 worldPos, Color color, const char* msg);
-float Game_IsNight(const Game* g);   // returns 0 or 1 right now
+void Game_AddPop(Game* g, Vector2 worldPos, Color color, const char* msg);   // floating text plus a sparkle
+void Game_Burst(Game* g, GameFx fx, Vector2 worldPos, Color tint, int count);
+float Game_IsNight(const Game* g);
+bool  Game_CanStart(const Game* g);   // false while the sprites a run needs are still loading
+Rectangle Game_ViewRect(const Game* g); // world rectangle covered by the camera
+unsigned Game_Rand(Game* g);            // gameplay randomness; never use rand() in the simulation
+unsigned Game_Checksum(const Game* g);  // hash of the simulation state, for replay sync checks
 
 #endif // GAME_H
@@ -0,0 +1,202 @@
+// Headless simulation runner: no window, no GL context, no audio device.
+// Build with `make headless`: every .c with SO_HEADLESS defined, so main.c
+// steps aside and headless_raylib.c stands in for raylib (nothing of raylib is
+// linked). Then run
+//   so_headless [--ticks N] [--seed S] [--horde N] [--record file | --replay file]
+//               [--trace first:last]   (ticks, written to trace.json)
+//               [--load file] [--save file] [--autosave file]
+//               [--workers N]          (threads that help generate chunks)
+// Input comes from a seeded scripted bot, or from a replay log. Ticks run
+// back to back as fast as possible; the report shows ticks/sec and where the
+// time went per subsystem.
+#ifdef SO_HEADLESS
+
+#include "raylib.h"
+#include "game.h"
+#include "player.h"
+#include "rival.h"
+#include "world.h"
+#include "replay.h"
+#include "timer.h"
+#include "profile.h"
+#include "snapshot.h"
+#include "thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BOT_SCREEN_W 1100   // same as the windowed default
+#define BOT_SCREEN_H 650
+
+typedef struct Bot {
+    unsigned rng;
+    unsigned moveBits;    // held direction buttons
+    int      moveTicks;   // ticks until the bot picks a new heading
+    Vector2  aim;         // mouse position, moved along with the heading
+} Bot;
+
+static unsigned BotRand(Bot* b) {
+    unsigned x = b->rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return b->rng = x;
+}
+
+// Plays like a restless player: wanders, sprints, grabs whatever is in
+// reach, eats and drinks when low, crafts and swings the spear. Menus and
+// end screens are confirmed so long runs keep cycling through games.
+static void Bot_Think(Bot* b, const Game* g, Input* in) {
+    static const unsigned kHeadings[8] = {
+        1u << BTN_UP, 1u << BTN_DOWN, 1u << BTN_LEFT, 1u << BTN_RIGHT,
+        (1u << BTN_UP) | (1u << BTN_LEFT), (1u << BTN_UP) | (1u << BTN_RIGHT),
+        (1u << BTN_DOWN) | (1u << BTN_LEFT), (1u << BTN_DOWN) | (1u << BTN_RIGHT),
+    };
+
+    in->down = 0;
+    in->pressed = 0;
+    in->mouse = b->aim;
+    in->screenW = BOT_SCREEN_W;
+    in->screenH = BOT_SCREEN_H;
+
+    if (g->state != STATE_PLAYING) {
+        if (BotRand(b) % 16 == 0) in->pressed |= 1u << BTN_CONFIRM;   // story lines need a short pause
+        return;
+    }
+
+    if (--b->moveTicks <= 0) {
+        b->moveBits = kHeadings[BotRand(b) % 8];
+        b->moveTicks = 30 + (int)(BotRand(b) % 90);
+        b->aim = (Vector2){ (float)(BotRand(b) % BOT_SCREEN_W), (float)(BotRand(b) % BOT_SCREEN_H) };
+    }
+    in->down = b->moveBits;
+    if ((b->moveTicks / 20) % 3 == 0) in->down |= 1u << BTN_SPRINT;   // sprint in bursts
+
+    const Player* p = g->player;
+    if (g->nearNode != NODE_NONE)                          in->pressed |= 1u << BTN_GATHER;
+    if (p->hunger < 50.0f && p->invFood > 0)               in->pressed |= 1u << BTN_EAT;
+    if (p->thirst < 50.0f && p->invWater > 0)              in->pressed |= 1u << BTN_DRINK;
+    if (!p->hasSpear && p->invStick >= 2)                  in->pressed |= 1u << BTN_CRAFT;
+    if (p->hasSpear && BotRand(b) % 20 == 0)               in->pressed |= 1u << BTN_ATTACK;
+}
+
+static void PrintRow(const char* name, double seconds, double total, unsigned long long ticks) {
+    printf("  %-8s %10.1f ms %9.3f us/tick %6.1f%%\n", name, seconds * 1e3,
+        ticks ? seconds * 1e6 / (double)ticks : 0.0, total > 0.0 ? 100.0 * seconds / total : 0.0);
+}
+
+int main(int argc, char** argv) {
+    long long   ticks = -1;            // default: 100000, or the whole replay
+    unsigned    seed = 1;
+    int         hordeSize = 1;
+    const char* recordPath = NULL;
+    const char* replayPath = NULL;
+    int         traceFirst = -1, traceLast = -1;
+    const char* loadPath = NULL;       // start from this snapshot
+    const char* savePath = NULL;       // snapshot the final state here
+    const char* autosavePath = NULL;   // autosave on a worker while running
+    int         workerCount = 0;       // world generation helpers; 0 generates inline
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)       ticks = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)   seed = (unsigned)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--horde") == 0 && i + 1 < argc)  hordeSize = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replayPath = argv[++i];
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc && sscanf(argv[++i], "%d:%d", &traceFirst, &traceLast) == 2) {}
+        else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc)     loadPath = argv[++i];
+        else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc)     savePath = argv[++i];
+        else if (strcmp(argv[i], "--autosave") == 0 && i + 1 < argc) autosavePath = argv[++i];
+        else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc)  workerCount = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--ticks N] [--seed S] [--horde N] [--record file | --replay file] [--trace first:last]"
+                " [--load file] [--save file] [--autosave file] [--workers N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (ticks < 0) ticks = replayPath ? (1LL << 62) : 100000;
+    SetTraceLogLevel(LOG_WARNING);
+    if (traceFirst >= 0) {
+        Prof_SetThreadName("sim");
+        Prof_CaptureFrames(traceFirst, traceLast, "trace.json");   // zones stay off otherwise
+    }
+
+    Replay replay = { 0 };
+    if (replayPath) {
+        if (!Replay_BeginPlayback(&replay, replayPath)) return 1;
+        seed = replay.seed;
+        hordeSize = replay.hordeSize;
+    }
+    else if (recordPath) {
+        if (!Replay_BeginRecord(&replay, recordPath, seed, hordeSize)) return 1;
+    }
+
+    // no Audio_Init: sound requests are dropped. Assets are only used to draw.
+    // the world comes out the same whatever the worker count; only the time changes
+    WorkerPool* workers = NULL;
+    if (workerCount > 0 || autosavePath) workers = WorkerPool_Create(workerCount > 0 ? workerCount : 1);
+
+    static Game G;
+    G.hordeSize = hordeSize;
+    G.workers = workerCount > 0 ? workers : NULL;
+    Game_Init(&G, NULL, seed);
+    if (loadPath) {
+        double t0 = Timer_Now();
+        if (!Snapshot_Load(&G, loadPath)) { fprintf(stderr, "headless: cannot load %s\n", loadPath); return 1; }
+        printf("loaded %s in %.2f ms\n", loadPath, (Timer_Now() - t0) * 1e3);
+    }
+    if (autosavePath) {
+        G.autosave.path = autosavePath;
+        G.autosave.workers = workers;
+    }
+
+    Bot bot = { .rng = seed * 2654435761u + 1u };
+    long long done = 0;
+    double start = Timer_Now();
+
+    for (; done < ticks; done++) {
+        Prof_FrameMark();
+        if (replayPath) {
+            if (!Replay_Tick(&replay, &G.input)) break;
+        }
+        else {
+            Bot_Think(&bot, &G, &G.input);
+            if (recordPath) Replay_Tick(&replay, &G.input);
+        }
+        Game_Update(&G, SIM_DT);
+        Input_Consume(&G.input);
+        if (G.quitRequested) { done++; break; }
+    }
+
+    double wall = Timer_Now() - start;
+    const SimTimings* t = &G.timings;
+    double other = t->total - t->player - t->flow - t->rival - t->collide - t->world;
+
+    printf("headless: %lld ticks in %.3f s -> %.0f ticks/s (%.0fx realtime at %d Hz)\n",
+        done, wall, wall > 0.0 ? done / wall : 0.0, wall > 0.0 ? done / wall / SIM_HZ : 0.0, SIM_HZ);
+    PrintRow("player", t->player, t->total, t->ticks);
+    PrintRow("flow", t->flow, t->total, t->ticks);
+    PrintRow("rival", t->rival, t->total, t->ticks);
+    PrintRow("collide", t->collide, t->total, t->ticks);
+    PrintRow("world", t->world, t->total, t->ticks);
+    PrintRow("other", other, t->total, t->ticks);
+    PrintRow("total", t->total, t->total, t->ticks);
+    printf("state %d, hp %d, clues %d, nodes %d, rivals %d, player at (%.0f, %.0f), checksum %08x\n",
+        (int)G.state, G.player->hp, G.cluesCollected, G.nodes.count, G.rivals.count,
+        G.player->pos.x, G.player->pos.y, Game_Checksum(&G));
+
+    if (savePath) {
+        double t0 = Timer_Now();
+        SnapshotCapture* c = Snapshot_Capture(&G);
+        double t1 = Timer_Now();
+        bool ok = Snapshot_WriteCapture(c, savePath);
+        printf("save %s: capture %.3f ms, encode + write %.2f ms%s\n", savePath,
+            (t1 - t0) * 1e3, (Timer_Now() - t1) * 1e3, ok ? "" : " (FAILED)");
+    }
+
+    Replay_End(&replay, Game_Checksum(&G));
+    Game_Shutdown(&G);
+    WorkerPool_Destroy(workers);
+    return 0;
+}
+
+#endif // SO_HEADLESS
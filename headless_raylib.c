@@ -0,0 +1,237 @@
+// raylib stand-ins for the headless build, so it links without raylib: no
+// window, GL or audio code at all, only raylib.h for the types. The few calls
+// the simulation depends on (memory, logging, text formatting, the camera
+// transform, rectangle tests) do what raylib does, with the same arithmetic
+// in the same order so ticks come out the same as in the game. Everything that
+// would draw, load GPU or audio resources, or poll a window does nothing and
+// hands back empty handles. A raylib call added anywhere in the tree without
+// a stand-in here shows up as a link error in `make headless`.
+#ifdef SO_HEADLESS
+
+#include "raylib.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- memory, logging, text ---
+void* MemAlloc(unsigned int size) { return calloc(size, 1); }
+void* MemRealloc(void* ptr, unsigned int size) { return realloc(ptr, size); }
+void  MemFree(void* ptr) { free(ptr); }
+
+static int logLevel = LOG_INFO;
+
+void SetTraceLogLevel(int level) { logLevel = level; }
+
+void TraceLog(int level, const char* text, ...) {
+    static const char* kPrefix[] = { "", "TRACE: ", "DEBUG: ", "INFO: ", "WARNING: ", "ERROR: ", "FATAL: ", "" };
+    if (level < logLevel) return;
+    va_list args;
+    va_start(args, text);
+    printf("%s", level >= LOG_ALL && level <= LOG_NONE ? kPrefix[level] : "");
+    vprintf(text, args);
+    printf("\n");
+    fflush(stdout);
+    va_end(args);
+    if (level == LOG_FATAL) exit(EXIT_FAILURE);
+}
+
+// a few rotating buffers, so a handful of results can be used at once
+const char* TextFormat(const char* text, ...) {
+    static char buffers[4][1024];
+    static int  index;
+    char* out = buffers[index];
+    index = (index + 1) % 4;
+    va_list args;
+    va_start(args, text);
+    vsnprintf(out, sizeof(buffers[0]), text, args);
+    va_end(args);
+    return out;
+}
+
+int MeasureText(const char* text, int fontSize) { (void)text; (void)fontSize; return 0; }
+Font GetFontDefault(void) { return (Font){ 0 }; }
+int  GetGlyphIndex(Font font, int codepoint) { (void)font; (void)codepoint; return 0; }
+int  GetCodepointNext(const char* text, int* codepointSize) { *codepointSize = 1; return (unsigned char)text[0]; }
+
+bool FileExists(const char* fileName) {
+    FILE* f = fopen(fileName, "rb");
+    if (f) fclose(f);
+    return f != NULL;
+}
+
+int GetRandomValue(int min, int max) {
+    if (min > max) { int t = max; max = min; min = t; }
+    return rand() % (abs(max - min) + 1) + min;
+}
+
+// --- maths ---
+Color Fade(Color color, float alpha) {
+    if (alpha < 0.0f) alpha = 0.0f;
+    else if (alpha > 1.0f) alpha = 1.0f;
+    return (Color){ color.r, color.g, color.b, (unsigned char)(255.0f * alpha) };
+}
+
+bool CheckCollisionRecs(Rectangle a, Rectangle b) {
+    return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+// 4x4 matrices as raymath lays them out: m[i] is raymath's field m<i>, so
+// m[12..14] is the translation.
+static void MatIdentity(float* m) { memset(m, 0, 16 * sizeof(float)); m[0] = m[5] = m[10] = m[15] = 1.0f; }
+
+static void MatMultiply(const float* l, const float* r, float* out) {
+    for (int row = 0; row < 4; row++)
+        for (int col = 0; col < 4; col++)
+            out[row * 4 + col] = l[row * 4] * r[col] + l[row * 4 + 1] * r[4 + col] + l[row * 4 + 2] * r[8 + col] + l[row * 4 + 3] * r[12 + col];
+}
+
+static void MatInvert(const float* a, float* out) {
+    float b00 = a[0] * a[5] - a[1] * a[4], b01 = a[0] * a[6] - a[2] * a[4];
+    float b02 = a[0] * a[7] - a[3] * a[4], b03 = a[1] * a[6] - a[2] * a[5];
+    float b04 = a[1] * a[7] - a[3] * a[5], b05 = a[2] * a[7] - a[3] * a[6];
+    float b06 = a[8] * a[13] - a[9] * a[12], b07 = a[8] * a[14] - a[10] * a[12];
+    float b08 = a[8] * a[15] - a[11] * a[12], b09 = a[9] * a[14] - a[10] * a[13];
+    float b10 = a[9] * a[15] - a[11] * a[13], b11 = a[10] * a[15] - a[11] * a[14];
+    float invDet = 1.0f / (b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06);
+
+    out[0] = (a[5] * b11 - a[6] * b10 + a[7] * b09) * invDet;
+    out[1] = (-a[1] * b11 + a[2] * b10 - a[3] * b09) * invDet;
+    out[2] = (a[13] * b05 - a[14] * b04 + a[15] * b03) * invDet;
+    out[3] = (-a[9] * b05 + a[10] * b04 - a[11] * b03) * invDet;
+    out[4] = (-a[4] * b11 + a[6] * b08 - a[7] * b07) * invDet;
+    out[5] = (a[0] * b11 - a[2] * b08 + a[3] * b07) * invDet;
+    out[6] = (-a[12] * b05 + a[14] * b02 - a[15] * b01) * invDet;
+    out[7] = (a[8] * b05 - a[10] * b02 + a[11] * b01) * invDet;
+    out[8] = (a[4] * b10 - a[5] * b08 + a[7] * b06) * invDet;
+    out[9] = (-a[0] * b10 + a[1] * b08 - a[3] * b06) * invDet;
+    out[10] = (a[12] * b04 - a[13] * b02 + a[15] * b00) * invDet;
+    out[11] = (-a[8] * b04 + a[9] * b02 - a[11] * b00) * invDet;
+    out[12] = (-a[4] * b09 + a[5] * b07 - a[6] * b06) * invDet;
+    out[13] = (a[0] * b09 - a[1] * b07 + a[2] * b06) * invDet;
+    out[14] = (-a[12] * b03 + a[13] * b01 - a[14] * b00) * invDet;
+    out[15] = (a[8] * b03 - a[9] * b01 + a[10] * b00) * invDet;
+}
+
+// GetCameraMatrix2D: translate by -target, scale, rotate about z, translate by offset
+static void CameraMatrix(Camera2D cam, float* out) {
+    float origin[16], rotation[16], scale[16], translation[16], scaleRot[16], tmp[16];
+    MatIdentity(origin);
+    origin[12] = -cam.target.x;
+    origin[13] = -cam.target.y;
+
+    float s = sinf(cam.rotation * DEG2RAD), c = cosf(cam.rotation * DEG2RAD);
+    MatIdentity(rotation);   // MatrixRotate about (0, 0, 1), zero terms dropped
+    rotation[0] = c;   rotation[1] = s;
+    rotation[4] = -s;  rotation[5] = c;
+    rotation[10] = (1.0f - c) + c;
+
+    MatIdentity(scale);
+    scale[0] = scale[5] = cam.zoom;
+    MatIdentity(translation);
+    translation[12] = cam.offset.x;
+    translation[13] = cam.offset.y;
+
+    MatMultiply(scale, rotation, scaleRot);
+    MatMultiply(origin, scaleRot, tmp);
+    MatMultiply(tmp, translation, out);
+}
+
+static Vector2 Transform(Vector2 p, const float* m) {
+    return (Vector2){ m[0] * p.x + m[4] * p.y + m[12], m[1] * p.x + m[5] * p.y + m[13] };   // z = 0
+}
+
+Vector2 GetScreenToWorld2D(Vector2 position, Camera2D camera) {
+    float m[16], inv[16];
+    CameraMatrix(camera, m);
+    MatInvert(m, inv);
+    return Transform(position, inv);
+}
+
+Vector2 GetWorldToScreen2D(Vector2 position, Camera2D camera) {
+    float m[16];
+    CameraMatrix(camera, m);
+    return Transform(position, m);
+}
+
+// --- no window: nothing to poll ---
+int     GetScreenWidth(void) { return 0; }
+int     GetScreenHeight(void) { return 0; }
+int     GetFPS(void) { return 0; }
+double  GetTime(void) { return 0.0; }
+bool    IsKeyDown(int key) { (void)key; return false; }
+bool    IsKeyPressed(int key) { (void)key; return false; }
+Vector2 GetMousePosition(void) { return (Vector2){ 0.0f, 0.0f }; }
+
+// --- no GL: drawing and GPU resources ---
+void ClearBackground(Color color) { (void)color; }
+void BeginMode2D(Camera2D camera) { (void)camera; }
+void EndMode2D(void) {}
+void BeginTextureMode(RenderTexture2D target) { (void)target; }
+void EndTextureMode(void) {}
+void BeginShaderMode(Shader shader) { (void)shader; }
+void EndShaderMode(void) {}
+void BeginBlendMode(int mode) { (void)mode; }
+void EndBlendMode(void) {}
+void BeginScissorMode(int x, int y, int width, int height) { (void)x; (void)y; (void)width; (void)height; }
+void EndScissorMode(void) {}
+
+void DrawLine(int x0, int y0, int x1, int y1, Color color) { (void)x0; (void)y0; (void)x1; (void)y1; (void)color; }
+void DrawLineEx(Vector2 a, Vector2 b, float thick, Color color) { (void)a; (void)b; (void)thick; (void)color; }
+void DrawCircleV(Vector2 center, float radius, Color color) { (void)center; (void)radius; (void)color; }
+void DrawCircleGradient(int x, int y, float radius, Color inner, Color outer) { (void)x; (void)y; (void)radius; (void)inner; (void)outer; }
+void DrawEllipse(int x, int y, float rh, float rv, Color color) { (void)x; (void)y; (void)rh; (void)rv; (void)color; }
+void DrawRectangle(int x, int y, int width, int height, Color color) { (void)x; (void)y; (void)width; (void)height; (void)color; }
+void DrawRectangleRec(Rectangle rec, Color color) { (void)rec; (void)color; }
+void DrawRectanglePro(Rectangle rec, Vector2 origin, float rotation, Color color) { (void)rec; (void)origin; (void)rotation; (void)color; }
+void DrawRectangleLines(int x, int y, int width, int height, Color color) { (void)x; (void)y; (void)width; (void)height; (void)color; }
+void DrawText(const char* text, int x, int y, int fontSize, Color color) { (void)text; (void)x; (void)y; (void)fontSize; (void)color; }
+void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint) { (void)texture; (void)source; (void)position; (void)tint; }
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    (void)texture; (void)source; (void)dest; (void)origin; (void)rotation; (void)tint;
+}
+void SetShapesTexture(Texture2D texture, Rectangle source) { (void)texture; (void)source; }
+
+Image GenImageColor(int width, int height, Color color) { (void)width; (void)height; (void)color; return (Image){ 0 }; }
+Image LoadImage(const char* fileName) { (void)fileName; return (Image){ 0 }; }
+void  UnloadImage(Image image) { (void)image; }
+void  ImageFormat(Image* image, int newFormat) { (void)image; (void)newFormat; }
+void  ImageDrawPixel(Image* dst, int x, int y, Color color) { (void)dst; (void)x; (void)y; (void)color; }
+void  ImageDrawRectangle(Image* dst, int x, int y, int width, int height, Color color) { (void)dst; (void)x; (void)y; (void)width; (void)height; (void)color; }
+void  ImageDrawCircle(Image* dst, int x, int y, int radius, Color color) { (void)dst; (void)x; (void)y; (void)radius; (void)color; }
+void  ImageDrawCircleLines(Image* dst, int x, int y, int radius, Color color) { (void)dst; (void)x; (void)y; (void)radius; (void)color; }
+
+Texture2D LoadTextureFromImage(Image image) { (void)image; return (Texture2D){ 0 }; }
+void      UnloadTexture(Texture2D texture) { (void)texture; }
+void      UpdateTexture(Texture2D texture, const void* pixels) { (void)texture; (void)pixels; }
+void      SetTextureFilter(Texture2D texture, int filter) { (void)texture; (void)filter; }
+void      SetTextureWrap(Texture2D texture, int wrap) { (void)texture; (void)wrap; }
+RenderTexture2D LoadRenderTexture(int width, int height) { (void)width; (void)height; return (RenderTexture2D){ 0 }; }
+void      UnloadRenderTexture(RenderTexture2D target) { (void)target; }
+
+Shader LoadShaderFromMemory(const char* vsCode, const char* fsCode) { (void)vsCode; (void)fsCode; return (Shader){ 0 }; }
+void   UnloadShader(Shader shader) { (void)shader; }
+int    GetShaderLocation(Shader shader, const char* name) { (void)shader; (void)name; return -1; }
+void   SetShaderValue(Shader shader, int loc, const void* value, int type) { (void)shader; (void)loc; (void)value; (void)type; }
+void   SetShaderValueTexture(Shader shader, int loc, Texture2D texture) { (void)shader; (void)loc; (void)texture; }
+
+// --- no audio device ---
+Wave  LoadWave(const char* fileName) { (void)fileName; return (Wave){ 0 }; }
+void  UnloadWave(Wave wave) { (void)wave; }
+void  WaveFormat(Wave* wave, int sampleRate, int sampleSize, int channels) { (void)wave; (void)sampleRate; (void)sampleSize; (void)channels; }
+Sound LoadSoundFromWave(Wave wave) { (void)wave; return (Sound){ 0 }; }
+void  UnloadSound(Sound sound) { (void)sound; }
+void  PlaySound(Sound sound) { (void)sound; }
+bool  IsSoundPlaying(Sound sound) { (void)sound; return false; }
+void  SetSoundVolume(Sound sound, float volume) { (void)sound; (void)volume; }
+Music LoadMusicStream(const char* fileName) { (void)fileName; return (Music){ 0 }; }
+void  UnloadMusicStream(Music music) { (void)music; }
+void  PlayMusicStream(Music music) { (void)music; }
+void  PauseMusicStream(Music music) { (void)music; }
+void  ResumeMusicStream(Music music) { (void)music; }
+void  StopMusicStream(Music music) { (void)music; }
+void  UpdateMusicStream(Music music) { (void)music; }
+void  SetMusicVolume(Music music, float volume) { (void)music; (void)volume; }
+
+#endif // SO_HEADLESS
@@ -0,0 +1,36 @@
+#include "input.h"
+
+// two keys per button; 0 = unused
+static const int kKeys[BTN_COUNT][2] = {
+    [BTN_UP]      = { KEY_W, KEY_UP },
+    [BTN_DOWN]    = { KEY_S, KEY_DOWN },
+    [BTN_LEFT]    = { KEY_A, KEY_LEFT },
+    [BTN_RIGHT]   = { KEY_D, KEY_RIGHT },
+    [BTN_SPRINT]  = { KEY_LEFT_SHIFT, 0 },
+    [BTN_GATHER]  = { KEY_E, 0 },
+    [BTN_EAT]     = { KEY_ONE, 0 },
+    [BTN_DRINK]   = { KEY_TWO, 0 },
+    [BTN_CRAFT]   = { KEY_F, 0 },
+    [BTN_ATTACK]  = { KEY_SPACE, 0 },
+    [BTN_CONFIRM] = { KEY_ENTER, 0 },
+    [BTN_BACK]    = { KEY_ESCAPE, 0 },
+};
+
+void Input_Poll(Input* in) {
+    unsigned down = 0, pressed = 0;
+    for (int b = 0; b < BTN_COUNT; b++) {
+        for (int k = 0; k < 2 && kKeys[b][k]; k++) {
+            if (IsKeyDown(kKeys[b][k]))    down |= 1u << b;
+            if (IsKeyPressed(kKeys[b][k])) pressed |= 1u << b;
+        }
+    }
+    in->down = down;
+    in->pressed |= pressed;
+    in->mouse = GetMousePosition();
+    in->screenW = GetScreenWidth();
+    in->screenH = GetScreenHeight();
+}
+
+void Input_Consume(Input* in) {
+    in->pressed = 0;
+}
@@ -0,0 +1,45 @@
+#ifndef INPUT_H
+#define INPUT_H
+#include "raylib.h"
+#include <stdbool.h>
+#pragma once
+
+// Logical buttons the simulation reads. Keys are mapped here once, so the
+// fixed-step update never touches raylib's per-frame key state directly.
+typedef enum InputButton {
+    BTN_UP = 0,        // W / Up
+    BTN_DOWN,          // S / Down
+    BTN_LEFT,          // A / Left
+    BTN_RIGHT,         // D / Right
+    BTN_SPRINT,        // Left Shift
+    BTN_GATHER,        // E
+    BTN_EAT,           // 1
+    BTN_DRINK,         // 2
+    BTN_CRAFT,         // F
+    BTN_ATTACK,        // Space
+    BTN_CONFIRM,       // Enter
+    BTN_BACK,          // Escape
+    BTN_COUNT
+} InputButton;
+
+// Held state is refreshed every rendered frame. Press edges are latched until
+// a simulation tick consumes them, so a press is never lost on a frame that
+// runs zero ticks and never repeats on a frame that runs several.
+// This is everything the simulation may read from the platform in a tick
+// (screen size included, since it shapes the camera view), which is what
+// lets a replay log reproduce a session exactly.
+typedef struct Input {
+    unsigned down;       // bit per InputButton, held this frame
+    unsigned pressed;    // bit per InputButton, pressed since the last tick
+    Vector2  mouse;      // screen position
+    int      screenW;
+    int      screenH;
+} Input;
+
+void Input_Poll(Input* in);      // once per rendered frame
+void Input_Consume(Input* in);   // after each simulation tick
+
+static inline bool Input_Down(const Input* in, InputButton b)    { return (in->down >> b) & 1u; }
+static inline bool Input_Pressed(const Input* in, InputButton b) { return (in->pressed >> b) & 1u; }
+
+#endif
@@ -0,0 +1,228 @@
+#include "light.h"
+#include "assets.h"    // Assets_Begin*/End*
+#include "profile.h"
+#include <math.h>
+#include <string.h>
+
+// Four cells at a time with SSE; define LIGHT_SCALAR to force the plain C
+// path. Rows are padded to a multiple of 4 cells, so there is no tail.
+#if !defined(LIGHT_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define LIGHT_SSE 1
+#include <emmintrin.h>
+#endif
+
+#define LIGHT_CONE_SOFT 0.06f   // cone edge fade, in cosine units
+#define LIGHT_EPS       1e-3f
+
+// An occluder relative to the light being accumulated
+typedef struct Shadow {
+    float ox, oy, r2;
+    float d2;          // distance to the light, squared (for keeping the nearest)
+} Shadow;
+
+void Lightmap_Init(Lightmap* m) { *m = (Lightmap){ 0 }; }
+
+void Lightmap_Free(Lightmap* m) {
+    MemFree(m->r); MemFree(m->g); MemFree(m->b);
+    MemFree(m->pixels);
+    if (m->tex.id) UnloadTexture(m->tex);
+    *m = (Lightmap){ 0 };
+}
+
+void Lightmap_Begin(Lightmap* m, int screenW, int screenH, Color ambient) {
+    int w = (screenW + LIGHT_CELL - 1) / LIGHT_CELL, h = (screenH + LIGHT_CELL - 1) / LIGHT_CELL;
+    if (w < 1) w = 1;
+    if (h < 1) h = 1;
+    if (w != m->w || h != m->h) {
+        m->w = w;
+        m->h = h;
+        m->stride = (w + 3) & ~3;
+        size_t cells = (size_t)m->stride * h;
+        m->r = MemRealloc(m->r, (unsigned)(cells * sizeof(float)));
+        m->g = MemRealloc(m->g, (unsigned)(cells * sizeof(float)));
+        m->b = MemRealloc(m->b, (unsigned)(cells * sizeof(float)));
+        m->pixels = MemRealloc(m->pixels, (unsigned)((size_t)w * h * 4));
+    }
+    m->ambient[0] = ambient.r / 255.0f;
+    m->ambient[1] = ambient.g / 255.0f;
+    m->ambient[2] = ambient.b / 255.0f;
+    m->lightCount = 0;
+    m->occluderCount = 0;
+}
+
+static void AddLight(Lightmap* m, Vector2 pos, float radius, Color color, float intensity, float dir, float cosHalf) {
+    if (m->lightCount == LIGHT_MAX || radius <= 0.0f || intensity <= 0.0f) return;
+    m->lights[m->lightCount++] = (Light){
+        pos, radius,
+        color.r / 255.0f * intensity, color.g / 255.0f * intensity, color.b / 255.0f * intensity,
+        cosf(dir), sinf(dir), cosHalf,
+    };
+}
+
+void Lightmap_AddPoint(Lightmap* m, Vector2 pos, float radius, Color color, float intensity) {
+    AddLight(m, pos, radius, color, intensity, 0.0f, -1.0f);
+}
+
+void Lightmap_AddCone(Lightmap* m, Vector2 pos, float radius, float dir, float halfAngle, Color color, float intensity) {
+    AddLight(m, pos, radius, color, intensity, dir, cosf(halfAngle));
+}
+
+void Lightmap_AddOccluder(Lightmap* m, Vector2 pos, float radius) {
+    if (m->occluderCount < LIGHT_MAX_OCCLUDERS) m->occluders[m->occluderCount++] = (Occluder){ pos, radius };
+}
+
+// Occluders that can cast into this light's reach, nearest LIGHT_MAX_SHADOWS.
+// One containing the light is skipped: the light sits on top of it.
+static int GatherShadows(const Lightmap* m, const Light* L, Shadow* out) {
+    int n = 0;
+    for (int i = 0; i < m->occluderCount; i++) {
+        const Occluder* o = &m->occluders[i];
+        float ox = o->pos.x - L->pos.x, oy = o->pos.y - L->pos.y;
+        float d2 = ox * ox + oy * oy, r2 = o->radius * o->radius;
+        float reach = L->radius + o->radius;
+        if (d2 <= r2 || d2 >= reach * reach) continue;
+        Shadow s = { ox, oy, r2, d2 };
+        if (n < LIGHT_MAX_SHADOWS) { out[n++] = s; continue; }
+        int far = 0;   // full: replace the farthest if this one is nearer
+        for (int k = 1; k < n; k++) if (out[k].d2 > out[far].d2) far = k;
+        if (d2 < out[far].d2) out[far] = s;
+    }
+    return n;
+}
+
+#if !LIGHT_SSE
+// Light reaching one cell, (px, py) from the light. A cell is in shadow when
+// the segment from the light to it crosses an occluder; cells inside an
+// occluder stay lit so the obstacle itself shows.
+static float CellLight(const Light* L, float invR2, const Shadow* sh, int shadows, float px, float py) {
+    float d2 = px * px + py * py;
+    float f = 1.0f - d2 * invR2;
+    if (f <= 0.0f) return 0.0f;
+    f *= f;
+    if (L->cosHalf > -1.0f) {
+        float c = (px * L->dirX + py * L->dirY) / (sqrtf(d2) + LIGHT_EPS);
+        float e = (c - L->cosHalf) * (1.0f / LIGHT_CONE_SOFT);
+        f *= e < 0.0f ? 0.0f : e > 1.0f ? 1.0f : e;
+        if (f <= 0.0f) return 0.0f;
+    }
+    float inv = 1.0f / (d2 + LIGHT_EPS);
+    for (int k = 0; k < shadows; k++) {
+        const Shadow* s = &sh[k];
+        float t = (px * s->ox + py * s->oy) * inv;
+        t = t < 0.0f ? 0.0f : t > 1.0f ? 1.0f : t;
+        float ex = s->ox - t * px, ey = s->oy - t * py;
+        float qx = s->ox - px, qy = s->oy - py;
+        if (ex * ex + ey * ey < s->r2 && qx * qx + qy * qy >= s->r2) return 0.0f;
+    }
+    return f;
+}
+#endif
+
+static void Accumulate(Lightmap* m, const Light* L) {
+    const float cell = (float)LIGHT_CELL;
+    int cx0 = (int)floorf((L->pos.x - L->radius) / cell), cx1 = (int)ceilf((L->pos.x + L->radius) / cell);
+    int cy0 = (int)floorf((L->pos.y - L->radius) / cell), cy1 = (int)ceilf((L->pos.y + L->radius) / cell);
+    if (cx0 < 0) cx0 = 0;
+    if (cy0 < 0) cy0 = 0;
+    if (cx1 > m->w) cx1 = m->w;
+    if (cy1 > m->h) cy1 = m->h;
+    if (cx0 >= cx1 || cy0 >= cy1) return;
+    cx0 &= ~3;                   // whole groups of 4; the padding absorbs the overhang
+    cx1 = (cx1 + 3) & ~3;
+
+    Shadow sh[LIGHT_MAX_SHADOWS];
+    int shadows = GatherShadows(m, L, sh);
+    float invR2 = 1.0f / (L->radius * L->radius);
+
+    for (int cy = cy0; cy < cy1; cy++) {
+        float  py = (cy + 0.5f) * cell - L->pos.y;
+        float* rr = m->r + (size_t)cy * m->stride;
+        float* gg = m->g + (size_t)cy * m->stride;
+        float* bb = m->b + (size_t)cy * m->stride;
+#if LIGHT_SSE
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), eps = _mm_set1_ps(LIGHT_EPS);
+        const __m128 vInvR2 = _mm_set1_ps(invR2), vPy = _mm_set1_ps(py), py2 = _mm_mul_ps(vPy, vPy);
+        const __m128 lr = _mm_set1_ps(L->r), lg = _mm_set1_ps(L->g), lb = _mm_set1_ps(L->b);
+        const __m128 step = _mm_set1_ps(4.0f * cell);
+        float x0 = (cx0 + 0.5f) * cell - L->pos.x;
+        __m128 px = _mm_setr_ps(x0, x0 + cell, x0 + 2.0f * cell, x0 + 3.0f * cell);
+        for (int cx = cx0; cx < cx1; cx += 4, px = _mm_add_ps(px, step)) {
+            __m128 d2 = _mm_add_ps(_mm_mul_ps(px, px), py2);
+            __m128 f = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(d2, vInvR2)));
+            f = _mm_mul_ps(f, f);
+            if (L->cosHalf > -1.0f) {
+                __m128 c = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(L->dirX)), _mm_mul_ps(vPy, _mm_set1_ps(L->dirY)));
+                c = _mm_div_ps(c, _mm_add_ps(_mm_sqrt_ps(d2), eps));
+                __m128 e = _mm_mul_ps(_mm_sub_ps(c, _mm_set1_ps(L->cosHalf)), _mm_set1_ps(1.0f / LIGHT_CONE_SOFT));
+                f = _mm_mul_ps(f, _mm_min_ps(one, _mm_max_ps(zero, e)));
+            }
+            if (!_mm_movemask_ps(_mm_cmpgt_ps(f, zero))) continue;
+            __m128 inv = _mm_div_ps(one, _mm_add_ps(d2, eps));
+            for (int k = 0; k < shadows; k++) {
+                __m128 ox = _mm_set1_ps(sh[k].ox), oy = _mm_set1_ps(sh[k].oy), r2 = _mm_set1_ps(sh[k].r2);
+                __m128 t = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(px, ox), _mm_mul_ps(vPy, oy)), inv);
+                t = _mm_min_ps(one, _mm_max_ps(zero, t));
+                __m128 ex = _mm_sub_ps(ox, _mm_mul_ps(t, px)), ey = _mm_sub_ps(oy, _mm_mul_ps(t, vPy));
+                __m128 qx = _mm_sub_ps(ox, px), qy = _mm_sub_ps(oy, vPy);
+                __m128 hit = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)), r2);
+                __m128 inside = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)), r2);
+                f = _mm_andnot_ps(_mm_andnot_ps(inside, hit), f);
+            }
+            _mm_storeu_ps(rr + cx, _mm_add_ps(_mm_loadu_ps(rr + cx), _mm_mul_ps(f, lr)));
+            _mm_storeu_ps(gg + cx, _mm_add_ps(_mm_loadu_ps(gg + cx), _mm_mul_ps(f, lg)));
+            _mm_storeu_ps(bb + cx, _mm_add_ps(_mm_loadu_ps(bb + cx), _mm_mul_ps(f, lb)));
+        }
+#else
+        for (int cx = cx0; cx < cx1; cx++) {
+            float f = CellLight(L, invR2, sh, shadows, (cx + 0.5f) * cell - L->pos.x, py);
+            rr[cx] += f * L->r;
+            gg[cx] += f * L->g;
+            bb[cx] += f * L->b;
+        }
+#endif
+    }
+}
+
+static unsigned char ToByte(float v) { return v >= 1.0f ? 255 : (unsigned char)(v * 255.0f); }
+
+void Lightmap_Build(Lightmap* m) {
+    PROF_ZONE(zone, "Lightmap_Build");
+    size_t cells = (size_t)m->stride * m->h;
+    memset(m->r, 0, cells * sizeof(float));
+    memset(m->g, 0, cells * sizeof(float));
+    memset(m->b, 0, cells * sizeof(float));
+    for (int i = 0; i < m->lightCount; i++) Accumulate(m, &m->lights[i]);
+
+    unsigned char* px = m->pixels;
+    for (int y = 0; y < m->h; y++) {
+        size_t row = (size_t)y * m->stride;
+        for (int x = 0; x < m->w; x++, px += 4) {
+            px[0] = ToByte(m->ambient[0] + m->r[row + x]);
+            px[1] = ToByte(m->ambient[1] + m->g[row + x]);
+            px[2] = ToByte(m->ambient[2] + m->b[row + x]);
+            px[3] = 255;
+        }
+    }
+    PROF_END(zone);
+}
+
+Texture2D Lightmap_Upload(Lightmap* m) {
+    if (m->tex.id == 0 || m->tex.width != m->w || m->tex.height != m->h) {
+        if (m->tex.id) UnloadTexture(m->tex);
+        m->tex = LoadTextureFromImage((Image) { m->pixels, m->w, m->h, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 });
+        SetTextureFilter(m->tex, TEXTURE_FILTER_BILINEAR);
+        SetTextureWrap(m->tex, TEXTURE_WRAP_CLAMP);
+    }
+    else UpdateTexture(m->tex, m->pixels);
+    return m->tex;
+}
+
+void Lightmap_Draw(Lightmap* m) {
+    Lightmap_Upload(m);
+
+    // texel centres land on cell centres; the filter does the upscale
+    Assets_BeginBlendMode(BLEND_MULTIPLIED);
+    DrawTexturePro(m->tex, (Rectangle) { 0, 0, (float)m->w, (float)m->h },
+        (Rectangle) { 0, 0, (float)(m->w * LIGHT_CELL), (float)(m->h * LIGHT_CELL) }, (Vector2) { 0, 0 }, 0.0f, WHITE);
+    Assets_EndBlendMode();
+}
@@ -0,0 +1,58 @@
+#ifndef LIGHT_H
+#define LIGHT_H
+#include "raylib.h"
+#pragma once
+
+// Night lighting on a coarse screen-space grid. Each frame the owner adds
+// lights and occluders in screen pixels; Lightmap_Build accumulates every
+// light into the cells it reaches (hard shadows behind occluder circles) on
+// the CPU, and Lightmap_Draw uploads the grid and multiplies it over the
+// frame as one bilinear-filtered quad, which also softens the shadow edges.
+// A light only touches the cells inside its radius and tests only the
+// occluders that overlap it, so cost grows with lit area, not light count.
+#define LIGHT_CELL          8     // screen pixels per cell
+#define LIGHT_MAX           64    // lights per frame; extras are dropped
+#define LIGHT_MAX_OCCLUDERS 128   // occluders per frame
+#define LIGHT_MAX_SHADOWS   16    // occluders tested per light, nearest first past this
+
+typedef struct Light {
+    Vector2 pos;          // screen pixels
+    float   radius;       // falls to zero here
+    float   r, g, b;      // colour times intensity
+    float   dirX, dirY;   // cone axis (unit); unused for point lights
+    float   cosHalf;      // cosine of the cone half-angle; -1 = point light
+} Light;
+
+typedef struct Occluder {
+    Vector2 pos;
+    float   radius;
+} Occluder;
+
+typedef struct Lightmap {
+    int    w, h, stride;      // cells; rows are padded to a multiple of 4
+    float* r; float* g; float* b;   // light per cell, stride * h each
+    unsigned char* pixels;    // RGBA8, w * h
+    Texture2D tex;            // created on first draw, resized with the screen
+
+    float    ambient[3];
+    Light    lights[LIGHT_MAX];
+    int      lightCount;
+    Occluder occluders[LIGHT_MAX_OCCLUDERS];
+    int      occluderCount;
+} Lightmap;
+
+void Lightmap_Init(Lightmap* m);
+void Lightmap_Free(Lightmap* m);
+
+// Start a frame: clears lights and occluders, resizes the grid to the screen.
+// Unlit cells take the ambient colour.
+void Lightmap_Begin(Lightmap* m, int screenW, int screenH, Color ambient);
+void Lightmap_AddPoint(Lightmap* m, Vector2 pos, float radius, Color color, float intensity);
+void Lightmap_AddCone(Lightmap* m, Vector2 pos, float radius, float dir, float halfAngle, Color color, float intensity);
+void Lightmap_AddOccluder(Lightmap* m, Vector2 pos, float radius);
+
+void      Lightmap_Build(Lightmap* m);    // CPU only
+Texture2D Lightmap_Upload(Lightmap* m);   // to the GPU, for a compositor to sample
+void      Lightmap_Draw(Lightmap* m);     // upload + multiply over the screen; call outside Mode2D
+
+#endif
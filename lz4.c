@@ -0,0 +1,118 @@
+#include "lz4.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define HASH_BITS     12
+#define MIN_MATCH     4
+#define MF_LIMIT      12      // no match may start in the last 12 bytes
+#define LAST_LITERALS 5       // ... or cover any of the last 5
+#define MAX_OFFSET    65535
+
+static unsigned Read32(const unsigned char* p) { unsigned v; memcpy(&v, p, 4); return v; }
+static unsigned Hash(unsigned v) { return (v * 2654435761u) >> (32 - HASH_BITS); }
+
+// 15 in the token nibble, then 255s, then the remainder
+static unsigned char* PutLength(unsigned char* op, int len) {
+    for (len -= 15; len >= 255; len -= 255) *op++ = 255;
+    *op++ = (unsigned char)len;
+    return op;
+}
+
+// literals [lit, lit + litLen), then a match of matchLen at offset (matchLen 0: the last sequence)
+static unsigned char* PutSequence(unsigned char* op, const unsigned char* lit, int litLen, int offset, int matchLen) {
+    unsigned char* token = op++;
+    *token = (unsigned char)((litLen < 15 ? litLen : 15) << 4);
+    if (litLen >= 15) op = PutLength(op, litLen);
+    memcpy(op, lit, litLen);
+    op += litLen;
+    if (matchLen == 0) return op;
+
+    *op++ = (unsigned char)offset;
+    *op++ = (unsigned char)(offset >> 8);
+    int ml = matchLen - MIN_MATCH;
+    *token |= (unsigned char)(ml < 15 ? ml : 15);
+    if (ml >= 15) op = PutLength(op, ml);
+    return op;
+}
+
+int Lz4_Compress(unsigned char* dst, int dstCap, const unsigned char* src, int srcSize) {
+    if (dstCap < LZ4_BOUND(srcSize)) return -1;   // the worst case always fits, so the loop needn't check
+    int table[1 << HASH_BITS];                   // last position per hash; stale entries are caught by the compare
+    memset(table, 0, sizeof(table));
+
+    const unsigned char* ip = src;
+    const unsigned char* anchor = src;           // first byte not yet emitted
+    const unsigned char* end = src + srcSize;
+    unsigned char* op = dst;
+
+    if (srcSize > MF_LIMIT) {
+        const unsigned char* mfLimit = end - MF_LIMIT;
+        const unsigned char* matchLimit = end - LAST_LITERALS;
+        unsigned misses = 0;
+        while (ip < mfLimit) {
+            unsigned h = Hash(Read32(ip));
+            const unsigned char* ref = src + table[h];
+            table[h] = (int)(ip - src);
+            if (ref >= ip || ip - ref > MAX_OFFSET || Read32(ref) != Read32(ip)) {
+                ip += 1 + (misses++ >> 6);   // skip faster through incompressible data
+                continue;
+            }
+            misses = 0;
+
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) { ip--; ref--; }
+            const unsigned char* m = ip + MIN_MATCH;
+            const unsigned char* r = ref + MIN_MATCH;
+            while (m < matchLimit && *m == *r) { m++; r++; }
+
+            op = PutSequence(op, anchor, (int)(ip - anchor), (int)(ip - ref), (int)(m - ip));
+            ip = anchor = m;
+        }
+    }
+    op = PutSequence(op, anchor, (int)(end - anchor), 0, 0);
+    return (int)(op - dst);
+}
+
+// a length nibble of 15 continues in the following bytes; false once it
+// passes `cap`, the output room left
+static bool ReadLength(const unsigned char** ip, const unsigned char* end, int cap, int* len) {
+    if (*len != 15) return true;
+    unsigned char b;
+    do {
+        if (*ip >= end) return false;
+        b = *(*ip)++;
+        if (b > cap - *len) return false;   // more than the output can take; also keeps the sum in range
+        *len += b;
+    } while (b == 255);
+    return true;
+}
+
+int Lz4_Decompress(unsigned char* dst, int dstCap, const unsigned char* src, int srcSize) {
+    const unsigned char* ip = src;
+    const unsigned char* end = src + srcSize;
+    unsigned char* op = dst;
+    unsigned char* oend = dst + dstCap;
+
+    while (ip < end) {
+        unsigned token = *ip++;
+        int lit = token >> 4;
+        if (!ReadLength(&ip, end, (int)(oend - op), &lit) || lit > end - ip || lit > oend - op) return -1;
+        memcpy(op, ip, lit);
+        op += lit;
+        ip += lit;
+        if (ip == end) break;   // the last sequence has no match
+
+        if (end - ip < 2) return -1;
+        int offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        int len = token & 15;
+        if (!ReadLength(&ip, end, (int)(oend - op) - MIN_MATCH, &len)) return -1;
+        len += MIN_MATCH;
+        if (offset == 0 || offset > op - dst || len > oend - op) return -1;
+
+        const unsigned char* ref = op - offset;
+        if (offset >= len) memcpy(op, ref, len);
+        else for (int i = 0; i < len; i++) op[i] = ref[i];   // overlapping: repeats the last `offset` bytes
+        op += len;
+    }
+    return (int)(op - dst);
+}
@@ -0,0 +1,18 @@
+#ifndef LZ4_H
+#define LZ4_H
+#pragma once
+
+// LZ4 block format (no frame header, no checksum): a run of sequences, each a
+// token byte, literals copied verbatim, then a 16-bit back offset and length.
+// Compression is one greedy pass with a 4K-entry hash of the last position
+// each 4-byte prefix was seen; decompression is plain copies, no tables.
+// The end-of-block rules of the reference format are kept, so blocks are
+// interchangeable with liblz4's LZ4_compress_default/LZ4_decompress_safe.
+#define LZ4_BOUND(n) ((n) + (n) / 255 + 16)   // worst-case compressed size
+
+// Both return the bytes written to dst, or -1 if dst is too small (or the
+// input is malformed, for Lz4_Decompress).
+int Lz4_Compress(unsigned char* dst, int dstCap, const unsigned char* src, int srcSize);
+int Lz4_Decompress(unsigned char* dst, int dstCap, const unsigned char* src, int srcSize);
+
+#endif
@@ -3,34 +3,133 @@
 #include "game.h"
 #include "ui.h"
 #include "assets.h"
+#include "bench.h"
+#include "replay.h"
+#include "audio.h"
+#include "profile.h"
+#include "timer.h"
+#include "thread.h"
+#include "text.h"
+#include "snapshot.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+// The windowed game. Building with SO_HEADLESS swaps in headless.c instead.
+#ifndef SO_HEADLESS
+int main(int argc, char** argv) {
+    double launch = Timer_Now();
+
+    // offline tools run before any window or audio device exists
+    if (argc > 1 && strcmp(argv[1], "--bench-nodes") == 0) return Bench_Nodes();
+    if (argc > 1 && strcmp(argv[1], "--bench-flow") == 0) return Bench_Flow();
+    if (argc > 1 && strcmp(argv[1], "--bench-light") == 0) return Bench_Light();
+    if (argc > 1 && strcmp(argv[1], "--bench-particles") == 0) return Bench_Particles();
+    if (argc > 1 && strcmp(argv[1], "--bench-worldgen") == 0) return Bench_WorldGen();
+    if (argc > 1 && strcmp(argv[1], "--pack-assets") == 0) return Assets_Pack(argc > 2 ? argv[2] : ASSETS_BUNDLE_PATH) ? 0 : 1;
+
+    // --horde <n> spawns n rivals; --record <file> logs this session;
+    // --replay <file> plays one back (seed and horde size come from the log);
+    // --trace <first>:<last> writes those frames to trace.json;
+    // --trace-stutter <ms> writes the last second whenever a frame runs over;
+    // --sfx-budget <KB> caps the memory of expanded sound effects;
+    // --no-post draws the screen-wide effects as separate passes (no shader);
+    // --continue resumes the last autosave, paused
+    const char* recordPath = NULL;
+    const char* replayPath = NULL;
+    int hordeSize = 1;
+    bool noPost = false;
+    bool resume = false;
+    Prof_SetThreadName("main");
+    Prof_SetRecording(true);       // flight recorder, so F4 always has history to dump
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--no-post") == 0)     { noPost = true; continue; }
+        if (strcmp(argv[i], "--continue") == 0)    { resume = true; continue; }
+        if (i + 1 >= argc) break;   // the rest take a value
+        if (strcmp(argv[i], "--horde") == 0)       hordeSize = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--record") == 0) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0) replayPath = argv[++i];
+        else if (strcmp(argv[i], "--trace") == 0) {
+            int first = 0, last = 0;
+            if (sscanf(argv[++i], "%d:%d", &first, &last) == 2) Prof_CaptureFrames(first, last, "trace.json");
+        }
+        else if (strcmp(argv[i], "--trace-stutter") == 0) Prof_CaptureOnStutter(atof(argv[++i]));
+        else if (strcmp(argv[i], "--sfx-budget") == 0) {
+            char* end;
+            long kb = strtol(argv[++i], &end, 10);
+            if (end == argv[i] || *end || kb < 0 || kb > (1L << 20))   // up to 1 GB
+                TraceLog(LOG_WARNING, "AUDIO: bad --sfx-budget '%s', keeping %u KB", argv[i], AUDIO_SFX_BUDGET_DEFAULT >> 10);
+            else Audio_SetSfxBudget((size_t)kb << 10);
+        }
+    }
+
+    Replay replay = { 0 };
+    unsigned seed = (unsigned)time(NULL);
+    if (replayPath) {
+        if (!Replay_BeginPlayback(&replay, replayPath)) return 1;
+        seed = replay.seed;
+        hordeSize = replay.hordeSize;
+    }
+    else if (recordPath) {
+        if (!Replay_BeginRecord(&replay, recordPath, seed, hordeSize)) return 1;
+    }
 
-int main(void) {
     SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_VSYNC_HINT);
     InitWindow(1100, 650, "Survivor's Oath: Blood & Bonds");
     InitAudioDevice();
     SetTargetFPS(60);
 
+    // decoding happens on the workers while the intro screen is already up
+    WorkerPool* workers = WorkerPool_Create(0);
     Assets assets = { 0 };
-    Assets_Load(&assets);          // tries to load PNGs; makes placeholders if missing
+    Assets_BeginLoad(&assets, workers);   // bundle if packed, else PNGs with placeholders for the missing
+    Audio_Init(&assets);
 
     Game G = { 0 };
-    Game_Init(&G, &assets);
+    G.replay = replay.mode != REPLAY_OFF ? &replay : NULL;
+    G.hordeSize = hordeSize;
+    G.workers = workers;
+    Game_Init(&G, &assets, seed);
+    G.post.disabled = noPost;
+
+    // replays start from their seed, so they neither resume nor overwrite a save
+    if (!G.replay) {
+        G.autosave.path = SNAPSHOT_PATH;
+        G.autosave.workers = workers;
+        if (resume && Snapshot_Load(&G, SNAPSHOT_PATH)) G.state = STATE_PAUSED;   // ESC to play once the sprites are in
+    }
 
     while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
-        Game_Update(&G, dt);
+        Prof_FrameMark();
+        PROF_ZONE(frame, "Frame");
+        Assets_PumpLoad(&assets);  // upload whatever the workers finished
+        Game_Frame(&G, GetFrameTime());
 
         BeginDrawing();
+        Assets_ResetStats();
         Game_Draw(&G);
         UI_DrawOverlays(&G);       // HUD, bars, prompts
-        EndDrawing();
+        PROF_ZONE(present, "EndDrawing");
+        EndDrawing();              // includes the vsync wait
+        PROF_END(present);
+        PROF_END(frame);
 
+        if (launch > 0.0) {        // cold start: launch to the first frame that takes input
+            TraceLog(LOG_INFO, "STARTUP: first frame %.1f ms after launch", (Timer_Now() - launch) * 1e3);
+            launch = 0.0;
+        }
         if (G.quitRequested) break;
     }
 
+    Replay_End(&replay, Game_Checksum(&G));
     Game_Shutdown(&G);
+    Audio_Shutdown();
     Assets_Unload(&assets);
+    Text_Free();
+    WorkerPool_Destroy(workers);
     CloseAudioDevice();
     CloseWindow();
     return 0;
 }
+#endif // SO_HEADLESS
@@ -0,0 +1,62 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L   // mmap and friends under strict -std=c11
+#endif
+#include "mapfile.h"
+
+// NOTE: no raylib.h here -- windows.h and raylib.h clash on several names.
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+bool MappedFile_Open(MappedFile* m, const char* path) {
+    *m = (MappedFile){ 0 };
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) { CloseHandle(file); return false; }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) { CloseHandle(file); return false; }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+
+    m->data = view;
+    m->size = (size_t)size.QuadPart;
+    m->handle = file;
+    m->mapping = mapping;
+    return true;
+}
+
+void MappedFile_Close(MappedFile* m) {
+    if (m->data) {
+        UnmapViewOfFile(m->data);
+        CloseHandle(m->mapping);
+        CloseHandle(m->handle);
+    }
+    *m = (MappedFile){ 0 };
+}
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool MappedFile_Open(MappedFile* m, const char* path) {
+    *m = (MappedFile){ 0 };
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return false; }
+    void* view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // the mapping keeps the file alive
+    if (view == MAP_FAILED) return false;
+
+    m->data = view;
+    m->size = (size_t)st.st_size;
+    return true;
+}
+
+void MappedFile_Close(MappedFile* m) {
+    if (m->data) munmap((void*)m->data, m->size);
+    *m = (MappedFile){ 0 };
+}
+#endif
@@ -0,0 +1,19 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+#include <stdbool.h>
+#include <stddef.h>
+#pragma once
+
+// Read-only memory mapping of a whole file. The OS pages data in on first
+// touch, so opening is cheap and nothing is copied into the heap.
+typedef struct MappedFile {
+    const unsigned char* data;   // NULL when not open
+    size_t               size;
+    void*                handle; // platform handles, kept for MappedFile_Close
+    void*                mapping;
+} MappedFile;
+
+bool MappedFile_Open(MappedFile* m, const char* path);
+void MappedFile_Close(MappedFile* m);
+
+#endif
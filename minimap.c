@@ -0,0 +1,173 @@
+#include "minimap.h"
+#include "world.h"     // HOME_W, HOME_H
+#include "assets.h"    // Assets_Begin*/End*
+#include "profile.h"
+#include <math.h>
+#include <string.h>
+
+// opaque, so a repaint fully replaces a cell; Minimap_Draw applies the transparency
+static const Color kUnexplored = { 10, 12, 16, 255 };
+static const Color kExplored   = { 46, 58, 52, 255 };
+static const Color kMarker[NODE_TYPE_COUNT] = {
+    [NODE_BERRY] = { 230, 80, 90, 255 },
+    [NODE_STICK] = { 170, 130, 90, 255 },
+    [NODE_POND]  = { 60, 150, 230, 255 },
+    [NODE_CLUE]  = { 255, 220, 80, 255 },
+};
+
+void Minimap_Init(Minimap* m) {
+    *m = (Minimap){ 0 };
+    m->w = (int)ceilf(HOME_W / MAP_CELL);
+    m->h = (int)ceilf(HOME_H / MAP_CELL);
+    m->words = (m->w + 31) / 32;
+    m->explored = MemAlloc(m->words * m->h * sizeof(unsigned));   // zeroed
+    m->dirty = MemAlloc(MAP_DIRTY_MAX * sizeof(int));
+    m->lastCx = m->lastCy = -1;
+}
+
+void Minimap_Free(Minimap* m) {
+    MemFree(m->explored);
+    MemFree(m->dirty);
+    if (m->rt.id) UnloadRenderTexture(m->rt);
+    *m = (Minimap){ 0 };
+}
+
+static bool CellOf(const Minimap* m, Vector2 pos, int* cx, int* cy) {
+    *cx = (int)floorf(pos.x / MAP_CELL);
+    *cy = (int)floorf(pos.y / MAP_CELL);
+    return *cx >= 0 && *cy >= 0 && *cx < m->w && *cy < m->h;
+}
+
+static bool Explored(const Minimap* m, int cx, int cy) {
+    return (m->explored[cy * m->words + (cx >> 5)] >> (cx & 31)) & 1u;
+}
+
+static void QueuePatch(Minimap* m, int cx, int cy) {
+    if (m->dirtyCount < MAP_DIRTY_MAX) m->dirty[m->dirtyCount++] = cy * m->w + cx;
+    else m->full = true;
+}
+
+bool Minimap_IsExplored(const Minimap* m, Vector2 pos) {
+    int cx, cy;
+    return CellOf(m, pos, &cx, &cy) && Explored(m, cx, cy);
+}
+
+void Minimap_Reveal(Minimap* m, Vector2 pos, float radius) {
+    int pcx = (int)floorf(pos.x / MAP_CELL), pcy = (int)floorf(pos.y / MAP_CELL);
+    if (pcx == m->lastCx && pcy == m->lastCy && radius == m->lastRadius) return;
+    m->lastCx = pcx;
+    m->lastCy = pcy;
+    m->lastRadius = radius;
+
+    // cells whose centre is in reach; the bit test skips the ones already seen
+    int r = (int)ceilf(radius / MAP_CELL);
+    int x0 = pcx - r < 0 ? 0 : pcx - r, x1 = pcx + r >= m->w ? m->w - 1 : pcx + r;
+    int y0 = pcy - r < 0 ? 0 : pcy - r, y1 = pcy + r >= m->h ? m->h - 1 : pcy + r;
+    float r2 = radius * radius;
+    for (int cy = y0; cy <= y1; cy++) {
+        float dy = (cy + 0.5f) * MAP_CELL - pos.y;
+        unsigned* row = m->explored + cy * m->words;
+        for (int cx = x0; cx <= x1; cx++) {
+            float dx = (cx + 0.5f) * MAP_CELL - pos.x;
+            unsigned bit = 1u << (cx & 31);
+            if ((row[cx >> 5] & bit) || dx * dx + dy * dy > r2) continue;
+            row[cx >> 5] |= bit;
+            m->exploredCount++;
+            QueuePatch(m, cx, cy);
+        }
+    }
+}
+
+void Minimap_Restore(Minimap* m, const unsigned* explored) {
+    memcpy(m->explored, explored, m->words * m->h * sizeof(unsigned));
+    m->exploredCount = 0;
+    for (int i = 0; i < m->words * m->h; i++) {
+        for (unsigned v = explored[i]; v; v &= v - 1) m->exploredCount++;
+    }
+    m->dirtyCount = 0;
+    m->full = true;
+    m->lastCx = m->lastCy = -1;
+}
+
+void Minimap_OnTaken(Minimap* m, Vector2 pos) {
+    int cx, cy;
+    if (CellOf(m, pos, &cx, &cy) && Explored(m, cx, cy)) QueuePatch(m, cx, cy);
+}
+
+// Markers of untaken nodes near the patched area whose own cell is explored.
+// Ponds spill over into neighbouring cells, so they are redrawn over any
+// cell the patch painted.
+static void DrawMarkers(const Minimap* m, const NodeStore* nodes, Rectangle area) {
+    const float px = MAP_PX / MAP_CELL;   // minimap pixels per world unit
+    for (int t = 0; t < NODE_TYPE_COUNT; t++) {
+        float reach = t == NODE_POND ? NODE_POND_SOLID : MAP_CELL;
+        for (int pg = nodes->firstPage[t]; pg >= 0; pg = nodes->pages[pg]->nextOfType) {
+            const NodePage* page = nodes->pages[pg];
+            Rectangle b = page->bounds;
+            if (page->count == 0 || b.x > area.x + area.width + reach || b.x + b.width < area.x - reach ||
+                b.y > area.y + area.height + reach || b.y + b.height < area.y - reach) continue;
+            for (int i = 0; i < page->count; i++) {
+                Vector2 p = page->pos[i];
+                if (page->taken[i] || p.x < area.x - reach || p.x > area.x + area.width + reach ||
+                    p.y < area.y - reach || p.y > area.y + area.height + reach) continue;
+                if (!Minimap_IsExplored(m, p)) continue;
+                if (t == NODE_POND) DrawCircleV((Vector2) { p.x * px, p.y * px }, NODE_POND_SOLID * px, kMarker[t]);
+                else DrawRectangle((int)(p.x * px), (int)(p.y * px), MAP_PX, MAP_PX, kMarker[t]);
+            }
+        }
+    }
+}
+
+void Minimap_PrepareDraw(Minimap* m, const NodeStore* nodes) {
+    if (m->rt.id == 0) {
+        m->rt = LoadRenderTexture(m->w * MAP_PX, m->h * MAP_PX);
+        m->full = true;
+    }
+    if (!m->full && m->dirtyCount == 0) return;
+    PROF_ZONE(zone, "Minimap_Patch");
+
+    Assets_BeginTextureMode(m->rt);
+    Rectangle area;
+    if (m->full) {
+        ClearBackground(kUnexplored);
+        for (int cy = 0; cy < m->h; cy++) {
+            const unsigned* row = m->explored + cy * m->words;
+            for (int cx = 0; cx < m->w; cx++) {
+                if (row[cx >> 5] == 0) { cx |= 31; continue; }   // skip unseen words
+                if ((row[cx >> 5] >> (cx & 31)) & 1u) DrawRectangle(cx * MAP_PX, cy * MAP_PX, MAP_PX, MAP_PX, kExplored);
+            }
+        }
+        area = (Rectangle){ 0, 0, HOME_W, HOME_H };
+    }
+    else {
+        int x0 = m->w, y0 = m->h, x1 = -1, y1 = -1;
+        for (int i = 0; i < m->dirtyCount; i++) {
+            int cx = m->dirty[i] % m->w, cy = m->dirty[i] / m->w;
+            DrawRectangle(cx * MAP_PX, cy * MAP_PX, MAP_PX, MAP_PX, kExplored);
+            if (cx < x0) x0 = cx;
+            if (cx > x1) x1 = cx;
+            if (cy < y0) y0 = cy;
+            if (cy > y1) y1 = cy;
+        }
+        area = (Rectangle){ x0 * MAP_CELL, y0 * MAP_CELL, (x1 - x0 + 1) * MAP_CELL, (y1 - y0 + 1) * MAP_CELL };
+    }
+    DrawMarkers(m, nodes, area);
+    Assets_EndTextureMode();
+
+    m->dirtyCount = 0;
+    m->full = false;
+    PROF_END(zone);
+}
+
+void Minimap_Draw(const Minimap* m, int x, int y, Vector2 player) {
+    if (m->rt.id == 0) return;
+    float w = (float)m->rt.texture.width, h = (float)m->rt.texture.height;
+    DrawTextureRec(m->rt.texture, (Rectangle) { 0, 0, w, -h }, (Vector2) { (float)x, (float)y }, Fade(WHITE, 0.85f));
+    DrawRectangleLines(x - 1, y - 1, (int)w + 2, (int)h + 2, (Color) { 0, 0, 0, 200 });
+
+    // the player, pinned to the edge when outside the home region
+    float px = player.x * (MAP_PX / MAP_CELL), py = player.y * (MAP_PX / MAP_CELL);
+    px = px < 0.0f ? 0.0f : px > w ? w : px;
+    py = py < 0.0f ? 0.0f : py > h ? h : py;
+    DrawCircleV((Vector2) { x + px, y + py }, 2.5f, RAYWHITE);
+}
@@ -0,0 +1,45 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+#include "raylib.h"
+#include "nodes.h"
+#include <stdbool.h>
+#pragma once
+
+// Explored-area map of the home region. Which MAP_CELL squares the
+// flashlight has reached is one bit each; the picture is a render texture
+// that is only patched where something changed -- cells newly explored and
+// cells whose pickup was taken -- so a frame costs O(changed cells) to update
+// and one quad to draw, however much of the region has been seen.
+#define MAP_CELL      32.0f   // world units per explored bit
+#define MAP_PX        2       // minimap pixels per cell
+#define MAP_DIRTY_MAX 512     // patches queued per frame; beyond this the map redraws whole
+
+typedef struct Minimap {
+    unsigned* explored;       // bit per cell, rows of `words` 32-bit words
+    int       w, h, words;    // cells, words per row
+    int       exploredCount;
+
+    int*      dirty;          // cell indices to repaint
+    int       dirtyCount;
+    bool      full;           // repaint everything (new texture, or the queue overflowed)
+    int       lastCx, lastCy; // where the last reveal was centred
+    float     lastRadius;
+
+    RenderTexture2D rt;       // created by the first Minimap_PrepareDraw (needs a GL context)
+} Minimap;
+
+void Minimap_Init(Minimap* m);
+void Minimap_Free(Minimap* m);
+
+// Mark the cells within radius of pos explored. Cheap when nothing moved:
+// the scan only runs after pos changes cell or the radius changes.
+void Minimap_Reveal(Minimap* m, Vector2 pos, float radius);
+void Minimap_OnTaken(Minimap* m, Vector2 pos);   // repaint the cell a node left
+bool Minimap_IsExplored(const Minimap* m, Vector2 pos);
+void Minimap_Restore(Minimap* m, const unsigned* explored);   // words * h bits from a save; repaints whole
+
+// Patch the texture; call outside BeginMode2D and any other texture mode.
+void Minimap_PrepareDraw(Minimap* m, const NodeStore* nodes);
+void Minimap_Draw(const Minimap* m, int x, int y, Vector2 player);
+
+#endif
@@ -0,0 +1,191 @@
+#include "nodes.h"
+#include "raylib.h"
+#include "raymath.h"
+#include <math.h>
+#include <string.h>
+
+#define NODE_MIN_BUCKETS 1024
+
+void Nodes_Init(NodeStore* s) {
+    *s = (NodeStore){ 0 };
+    Arena_Init(&s->arena, 64 * sizeof(NodePage));
+    for (int t = 0; t < NODE_TYPE_COUNT; t++) s->firstPage[t] = s->lastPage[t] = -1;
+    s->freePage = -1;
+
+    s->bucketCount = NODE_MIN_BUCKETS;
+    s->buckets = MemAlloc(s->bucketCount * sizeof(NodeId));
+    for (int i = 0; i < s->bucketCount; i++) s->buckets[i] = NODE_NONE;
+}
+
+void Nodes_Free(NodeStore* s) {
+    Arena_Free(&s->arena);
+    MemFree(s->pages);
+    MemFree(s->buckets);
+    *s = (NodeStore){ 0 };
+}
+
+// -----------------------------------------------------------------------------
+// Spatial hash: linked nodes are bucketed by NODE_CELL cell, so a proximity
+// query only walks the few cells around a point instead of the whole world.
+static int CellOf(float v) { return (int)floorf(v / NODE_CELL); }
+
+static int BucketOf(const NodeStore* s, int cx, int cy) {
+    unsigned h = (unsigned)cx * 73856093u ^ (unsigned)cy * 19349663u;
+    return (int)(h & (unsigned)(s->bucketCount - 1));
+}
+
+static NodeId* NextOf(const NodeStore* s, NodeId id) { return &Nodes_Page(s, id)->next[Nodes_Slot(id)]; }
+
+static void Link(NodeStore* s, NodeId id) {
+    Vector2 p = Nodes_Pos(s, id);
+    int b = BucketOf(s, CellOf(p.x), CellOf(p.y));
+    *NextOf(s, id) = s->buckets[b];
+    s->buckets[b] = id;
+    s->linked++;
+}
+
+static void Unlink(NodeStore* s, NodeId id) {
+    Vector2 p = Nodes_Pos(s, id);
+    int b = BucketOf(s, CellOf(p.x), CellOf(p.y));
+    for (NodeId* link = &s->buckets[b]; *link != NODE_NONE; link = NextOf(s, *link)) {
+        if (*link == id) { *link = *NextOf(s, id); s->linked--; return; }
+    }
+}
+
+// keep chains short: double the table once it averages two nodes per bucket
+static void GrowBuckets(NodeStore* s) {
+    MemFree(s->buckets);
+    s->bucketCount *= 2;
+    s->buckets = MemAlloc(s->bucketCount * sizeof(NodeId));
+    for (int i = 0; i < s->bucketCount; i++) s->buckets[i] = NODE_NONE;
+
+    s->linked = 0;
+    for (int pg = 0; pg < s->pageCount; pg++) {
+        NodePage* page = s->pages[pg];
+        for (int i = 0; i < page->count; i++) {
+            if (!page->taken[i]) Link(s, (pg << NODE_PAGE_SHIFT) | i);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+int Nodes_NewPage(NodeStore* s, NodeType type) {
+    int idx;
+    if (s->freePage >= 0) {
+        idx = s->freePage;
+        s->freePage = s->pages[idx]->nextOfType;
+    }
+    else {
+        if (s->pageCount == s->pageCap) {
+            s->pageCap = s->pageCap ? s->pageCap * 2 : 16;
+            s->pages = MemRealloc(s->pages, s->pageCap * sizeof(NodePage*));
+        }
+        idx = s->pageCount++;
+        s->pages[idx] = Arena_Alloc(&s->arena, sizeof(NodePage));
+    }
+
+    NodePage* page = s->pages[idx];
+    page->count = 0;
+    page->bounds = (Rectangle){ 0 };
+    page->type = type;
+    page->nextOfType = -1;
+    page->prevOfType = s->lastPage[type];
+    if (s->lastPage[type] >= 0) s->pages[s->lastPage[type]]->nextOfType = idx;
+    else s->firstPage[type] = idx;
+    s->lastPage[type] = idx;
+    return idx;
+}
+
+void Nodes_FreePage(NodeStore* s, int pg) {
+    NodePage* page = s->pages[pg];
+    for (int i = 0; i < page->count; i++) {
+        if (!page->taken[i]) Unlink(s, (pg << NODE_PAGE_SHIFT) | i);
+    }
+    s->count -= page->count;
+    s->revision[page->type]++;
+    page->count = 0;
+
+    // unlink from the type list, then push on the free list
+    if (page->prevOfType >= 0) s->pages[page->prevOfType]->nextOfType = page->nextOfType;
+    else s->firstPage[page->type] = page->nextOfType;
+    if (page->nextOfType >= 0) s->pages[page->nextOfType]->prevOfType = page->prevOfType;
+    else s->lastPage[page->type] = page->prevOfType;
+
+    page->prevOfType = -1;
+    page->nextOfType = s->freePage;
+    s->freePage = pg;
+}
+
+NodeId Nodes_AddTo(NodeStore* s, int pg, Vector2 pos, int tag) {
+    NodePage* page = s->pages[pg];
+    if (page->count == NODE_PAGE_SIZE) return NODE_NONE;
+    if (s->linked >= s->bucketCount * 2) GrowBuckets(s);
+
+    if (page->count == 0) {
+        page->bounds = (Rectangle){ pos.x, pos.y, 0.0f, 0.0f };
+    }
+    else {
+        float x0 = fminf(page->bounds.x, pos.x), y0 = fminf(page->bounds.y, pos.y);
+        float x1 = fmaxf(page->bounds.x + page->bounds.width, pos.x);
+        float y1 = fmaxf(page->bounds.y + page->bounds.height, pos.y);
+        page->bounds = (Rectangle){ x0, y0, x1 - x0, y1 - y0 };
+    }
+
+    int slot = page->count++;
+    page->pos[slot] = pos;
+    page->taken[slot] = false;
+    page->tag[slot] = (unsigned char)tag;
+    s->count++;
+    s->revision[page->type]++;
+
+    NodeId id = (pg << NODE_PAGE_SHIFT) | slot;
+    Link(s, id);
+    return id;
+}
+
+NodeId Nodes_Add(NodeStore* s, NodeType type, Vector2 pos) {
+    int pg = s->lastPage[type];
+    if (pg < 0 || s->pages[pg]->count == NODE_PAGE_SIZE) pg = Nodes_NewPage(s, type);
+    return Nodes_AddTo(s, pg, pos, 0);
+}
+
+void Nodes_Take(NodeStore* s, NodeId id) {
+    NodePage* page = Nodes_Page(s, id);
+    int slot = Nodes_Slot(id);
+    if (page->taken[slot]) return;
+    page->taken[slot] = true;
+    Unlink(s, id);
+}
+
+// Interaction radius per node type, scaled to match the larger world sprites.
+// Gather() and the context prompt both go through Nodes_FindInteractable.
+float Nodes_InteractRadius(NodeType type) {
+    static const float R[NODE_TYPE_COUNT] = {
+        [NODE_BERRY] = 24.0f * NODE_SCALE,
+        [NODE_STICK] = 24.0f * NODE_SCALE,
+        [NODE_POND]  = 48.0f * NODE_SCALE,
+        [NODE_CLUE]  = 36.0f * NODE_SCALE,
+    };
+    return R[type];
+}
+
+NodeId Nodes_FindInteractable(const NodeStore* s, Vector2 pos) {
+    const float reach = Nodes_InteractRadius(NODE_POND);   // largest radius
+    int x0 = CellOf(pos.x - reach), x1 = CellOf(pos.x + reach);
+    int y0 = CellOf(pos.y - reach), y1 = CellOf(pos.y + reach);
+
+    NodeId best = NODE_NONE;
+    float bestD2 = 0.0f;
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            for (NodeId id = s->buckets[BucketOf(s, cx, cy)]; id != NODE_NONE; id = *NextOf(s, id)) {
+                const NodePage* page = Nodes_Page(s, id);
+                float r = Nodes_InteractRadius(page->type);
+                float d2 = Vector2DistanceSqr(pos, page->pos[Nodes_Slot(id)]);
+                if (d2 > r * r) continue;
+                if (best == NODE_NONE || d2 < bestD2) { best = id; bestD2 = d2; }
+            }
+        }
+    }
+    return best;
+}
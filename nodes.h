@@ -0,0 +1,75 @@
+#ifndef NODES_H
+#define NODES_H
+#include "raylib.h"
+#include "arena.h"
+#include <stdbool.h>
+#pragma once
+
+typedef enum NodeType {
+    NODE_BERRY = 0,
+    NODE_STICK,
+    NODE_POND,
+    NODE_CLUE,
+    NODE_TYPE_COUNT
+} NodeType;
+
+// Nodes live in fixed-size SoA pages allocated from an arena. Every page holds
+// a single node type, so drawing and pickups walk tight per-type ranges.
+// Pages never move, which keeps NodeIds stable until their page is freed;
+// freed pages go on a free list and are recycled, so memory tracks the peak.
+#define NODE_PAGE_SHIFT 8
+#define NODE_PAGE_SIZE  (1 << NODE_PAGE_SHIFT)
+#define NODE_CELL       128.0f   // spatial hash cell size (>= largest interact radius)
+#define NODE_SCALE      1.8f     // visual scale of world items (match player/rival)
+#define NODE_POND_SOLID (32.0f * NODE_SCALE)   // ponds block movement within this radius
+
+typedef int NodeId;              // (page << NODE_PAGE_SHIFT) | slot, -1 = none
+#define NODE_NONE (-1)
+
+typedef struct NodePage {
+    Vector2  pos[NODE_PAGE_SIZE];
+    bool     taken[NODE_PAGE_SIZE];
+    NodeId   next[NODE_PAGE_SIZE];   // spatial hash chain
+    unsigned char tag[NODE_PAGE_SIZE];  // owner-defined id (e.g. which clue)
+    int      count;
+    Rectangle bounds;                // AABB of pos[0..count), for page-level culling
+    NodeType type;
+    int      nextOfType;             // next page of the same type (or free page), -1 at the end
+    int      prevOfType;
+} NodePage;
+
+typedef struct NodeStore {
+    Arena      arena;                // backs the pages
+    NodePage** pages;                // page table, grows with MemRealloc
+    int        pageCount, pageCap;
+    int        firstPage[NODE_TYPE_COUNT];
+    int        lastPage[NODE_TYPE_COUNT];
+    int        freePage;             // recycled pages, chained by nextOfType
+    int        count;                // nodes in live pages
+    unsigned   revision[NODE_TYPE_COUNT];   // per type, bumped on every add and page free, so layout caches can tell
+    // spatial hash over interactable (not taken) nodes
+    NodeId*    buckets;
+    int        bucketCount;          // power of two, grows with the node count
+    int        linked;
+} NodeStore;
+
+void   Nodes_Init(NodeStore* s);
+void   Nodes_Free(NodeStore* s);
+NodeId Nodes_Add(NodeStore* s, NodeType type, Vector2 pos);
+void   Nodes_Take(NodeStore* s, NodeId id);          // marks taken + unlinks from the hash
+
+// page-level API for owners that add and drop nodes in groups (world chunks)
+int    Nodes_NewPage(NodeStore* s, NodeType type);
+NodeId Nodes_AddTo(NodeStore* s, int page, Vector2 pos, int tag);   // NODE_NONE if the page is full
+void   Nodes_FreePage(NodeStore* s, int page);      // unlinks its nodes; their NodeIds become invalid
+
+float  Nodes_InteractRadius(NodeType type);
+NodeId Nodes_FindInteractable(const NodeStore* s, Vector2 pos);  // nearest in reach, or NODE_NONE
+
+static inline NodePage* Nodes_Page(const NodeStore* s, NodeId id) { return s->pages[id >> NODE_PAGE_SHIFT]; }
+static inline int       Nodes_Slot(NodeId id) { return id & (NODE_PAGE_SIZE - 1); }
+static inline Vector2   Nodes_Pos(const NodeStore* s, NodeId id) { return Nodes_Page(s, id)->pos[Nodes_Slot(id)]; }
+static inline NodeType  Nodes_Type(const NodeStore* s, NodeId id) { return Nodes_Page(s, id)->type; }
+static inline int       Nodes_Tag(const NodeStore* s, NodeId id) { return Nodes_Page(s, id)->tag[Nodes_Slot(id)]; }
+
+#endif
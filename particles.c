@@ -0,0 +1,244 @@
+#include "particles.h"
+#include "text.h"
+#include "profile.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Same SIMD selection as the rival pool; the tail of every span runs scalar.
+#if !defined(PARTICLES_SCALAR) && defined(__AVX__)
+#define PARTICLES_AVX 1
+#include <immintrin.h>
+#elif !defined(PARTICLES_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PARTICLES_SSE 1
+#include <emmintrin.h>
+#endif
+
+#define RING_MASK  (PARTICLE_CAP - 1)
+#define TEXT_LIFE  0.9f      // seconds a pickup text floats
+#define TEXT_RISE  40.0f     // screen pixels per second
+#define TEXT_SIZE  16
+
+void Particles_Init(Particles* ps, unsigned seed) {
+    *ps = (Particles){ 0 };
+    ps->x = MemAlloc(PARTICLE_CAP * sizeof(float));
+    ps->y = MemAlloc(PARTICLE_CAP * sizeof(float));
+    ps->vx = MemAlloc(PARTICLE_CAP * sizeof(float));
+    ps->vy = MemAlloc(PARTICLE_CAP * sizeof(float));
+    ps->ay = MemAlloc(PARTICLE_CAP * sizeof(float));
+    ps->life = MemAlloc(PARTICLE_CAP * sizeof(float));
+    ps->invLife = MemAlloc(PARTICLE_CAP * sizeof(float));
+    ps->size = MemAlloc(PARTICLE_CAP * sizeof(float));
+    ps->color = MemAlloc(PARTICLE_CAP * sizeof(Color));
+    ps->kind = MemAlloc(PARTICLE_CAP);
+    ps->rng = seed ? seed : 0x2545F491u;
+}
+
+void Particles_Free(Particles* ps) {
+    MemFree(ps->x);  MemFree(ps->y);
+    MemFree(ps->vx); MemFree(ps->vy);
+    MemFree(ps->ay);
+    MemFree(ps->life);
+    MemFree(ps->invLife);
+    MemFree(ps->size);
+    MemFree(ps->color);
+    MemFree(ps->kind);
+    *ps = (Particles){ 0 };
+}
+
+void Particles_Clear(Particles* ps) {
+    ps->first = ps->count = ps->alive = 0;
+    memset(ps->texts, 0, sizeof(ps->texts));
+    ps->nextText = 0;
+}
+
+// xorshift32, uniform in [-1, 1)
+static float Signed(unsigned* s) {
+    unsigned x = *s;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    *s = x;
+    return (x & 0xFFFFFF) / (float)0x800000 - 1.0f;
+}
+
+// Next slot at the back of the ring; a full ring gives up its front.
+static int Spawn(Particles* ps) {
+    if (ps->count == PARTICLE_CAP) {
+        if (ps->life[ps->first] > 0.0f) ps->evicted++;
+        ps->first = (ps->first + 1) & RING_MASK;
+        ps->count--;
+    }
+    ps->alive++;
+    return (ps->first + ps->count++) & RING_MASK;
+}
+
+void Particles_Emit(Particles* ps, const ParticleEmitter* e, Vector2 at, int n) {
+    for (int k = 0; k < n; k++) {
+        int   i = Spawn(ps);
+        float a = e->angle + Signed(&ps->rng) * e->spread;
+        float v = e->speed + Signed(&ps->rng) * e->speedJitter;
+        float life = e->life + Signed(&ps->rng) * e->lifeJitter;
+        if (life < 0.05f) life = 0.05f;
+        ps->x[i] = at.x + Signed(&ps->rng) * e->area.x;
+        ps->y[i] = at.y + Signed(&ps->rng) * e->area.y;
+        ps->vx[i] = cosf(a) * v;
+        ps->vy[i] = sinf(a) * v;
+        ps->ay[i] = e->gravity;
+        ps->life[i] = life;
+        ps->invLife[i] = 1.0f / life;
+        ps->size[i] = e->size;
+        ps->color[i] = e->color;
+        ps->kind[i] = (unsigned char)e->kind;
+    }
+}
+
+void Particles_RunEmitter(Particles* ps, ParticleEmitter* e, Vector2 at, float dt) {
+    e->carry += e->rate * dt;
+    int n = (int)e->carry;
+    e->carry -= (float)n;
+    Particles_Emit(ps, e, at, n);
+}
+
+// Every text lives TEXT_LIFE, so the round-robin slot is always the oldest.
+void Particles_AddText(Particles* ps, Vector2 at, Color color, const char* msg) {
+    ParticleText* t = &ps->texts[ps->nextText++ & (PARTICLE_TEXT_SLOTS - 1)];
+#if defined(_MSC_VER)
+    strncpy_s(t->msg, PARTICLE_TEXT_LEN, msg, _TRUNCATE);
+#else
+    snprintf(t->msg, PARTICLE_TEXT_LEN, "%s", msg);
+#endif
+    t->pos = at;
+    t->life = TEXT_LIFE;
+    t->color = color;
+}
+
+// -----------------------------------------------------------------------------
+// Integration over [from, to): move, fall, age. Returns how many are still alive.
+static int IntegrateScalar(Particles* ps, int from, int to, float dt) {
+    int alive = 0;
+    for (int i = from; i < to; i++) {
+        ps->x[i] += ps->vx[i] * dt;
+        ps->y[i] += ps->vy[i] * dt;
+        ps->vy[i] += ps->ay[i] * dt;
+        ps->life[i] -= dt;
+        alive += ps->life[i] > 0.0f;
+    }
+    return alive;
+}
+
+static int CountBits(unsigned m) { int n = 0; while (m) { m &= m - 1; n++; } return n; }
+
+#if PARTICLES_AVX
+static int Integrate(Particles* ps, int from, int to, float dt) {
+    const __m256 vdt = _mm256_set1_ps(dt), zero = _mm256_setzero_ps();
+    int alive = 0, i = from;
+    for (; i + 8 <= to; i += 8) {
+        __m256 vx = _mm256_loadu_ps(ps->vx + i), vy = _mm256_loadu_ps(ps->vy + i);
+        _mm256_storeu_ps(ps->x + i, _mm256_add_ps(_mm256_loadu_ps(ps->x + i), _mm256_mul_ps(vx, vdt)));
+        _mm256_storeu_ps(ps->y + i, _mm256_add_ps(_mm256_loadu_ps(ps->y + i), _mm256_mul_ps(vy, vdt)));
+        _mm256_storeu_ps(ps->vy + i, _mm256_add_ps(vy, _mm256_mul_ps(_mm256_loadu_ps(ps->ay + i), vdt)));
+        __m256 life = _mm256_sub_ps(_mm256_loadu_ps(ps->life + i), vdt);
+        _mm256_storeu_ps(ps->life + i, life);
+        alive += CountBits((unsigned)_mm256_movemask_ps(_mm256_cmp_ps(life, zero, _CMP_GT_OQ)));
+    }
+    return alive + IntegrateScalar(ps, i, to, dt);
+}
+#elif PARTICLES_SSE
+static int Integrate(Particles* ps, int from, int to, float dt) {
+    const __m128 vdt = _mm_set1_ps(dt), zero = _mm_setzero_ps();
+    int alive = 0, i = from;
+    for (; i + 4 <= to; i += 4) {
+        __m128 vx = _mm_loadu_ps(ps->vx + i), vy = _mm_loadu_ps(ps->vy + i);
+        _mm_storeu_ps(ps->x + i, _mm_add_ps(_mm_loadu_ps(ps->x + i), _mm_mul_ps(vx, vdt)));
+        _mm_storeu_ps(ps->y + i, _mm_add_ps(_mm_loadu_ps(ps->y + i), _mm_mul_ps(vy, vdt)));
+        _mm_storeu_ps(ps->vy + i, _mm_add_ps(vy, _mm_mul_ps(_mm_loadu_ps(ps->ay + i), vdt)));
+        __m128 life = _mm_sub_ps(_mm_loadu_ps(ps->life + i), vdt);
+        _mm_storeu_ps(ps->life + i, life);
+        alive += CountBits((unsigned)_mm_movemask_ps(_mm_cmpgt_ps(life, zero)));
+    }
+    return alive + IntegrateScalar(ps, i, to, dt);
+}
+#else
+static int Integrate(Particles* ps, int from, int to, float dt) {
+    return IntegrateScalar(ps, from, to, dt);
+}
+#endif
+
+void Particles_Update(Particles* ps, float dt) {
+    for (int t = 0; t < PARTICLE_TEXT_SLOTS; t++)
+        if (ps->texts[t].life > 0.0f) ps->texts[t].life -= dt;
+    if (ps->count == 0) return;
+    PROF_ZONE(zone, "Particles_Update");
+    // the ring is at most two contiguous spans
+    int end = ps->first + ps->count;
+    if (end <= PARTICLE_CAP) ps->alive = Integrate(ps, ps->first, end, dt);
+    else ps->alive = Integrate(ps, ps->first, PARTICLE_CAP, dt) + Integrate(ps, 0, end - PARTICLE_CAP, dt);
+
+    // retire the dead front; holes further back wait their turn
+    while (ps->count > 0 && ps->life[ps->first] <= 0.0f) {
+        ps->first = (ps->first + 1) & RING_MASK;
+        ps->count--;
+    }
+    PROF_END(zone);
+}
+
+// -----------------------------------------------------------------------------
+// Drawing. Positions are pulled back along the velocity to where the particle
+// was at `alpha` between the last two updates.
+void Particles_Draw(const Particles* ps, Rectangle view, float alpha, float dt) {
+    if (ps->count == 0) return;
+    PROF_ZONE(zone, "Particles_Draw");
+    const float back = (1.0f - alpha) * dt;
+    const float m = 32.0f;   // longest streak
+    const float x0 = view.x - m, x1 = view.x + view.width + m;
+    const float y0 = view.y - m, y1 = view.y + view.height + m;
+
+    for (int k = 0; k < ps->count; k++) {
+        int i = (ps->first + k) & RING_MASK;
+        if (ps->life[i] <= 0.0f) continue;
+        float x = ps->x[i] - ps->vx[i] * back, y = ps->y[i] - ps->vy[i] * back;
+        if (x < x0 || x > x1 || y < y0 || y > y1) continue;
+
+        float f = ps->life[i] * ps->invLife[i];   // 1 at birth, 0 at death
+        float s = ps->size[i];
+        Color c = ps->color[i];
+        switch (ps->kind[i]) {
+        case PARTICLE_SPARK: s *= f; c.a = (unsigned char)(c.a * f); break;
+        case PARTICLE_DUST:  s *= 2.0f - f; c.a = (unsigned char)(c.a * f); break;
+        case PARTICLE_BLOOD: if (f < 0.33f) c.a = (unsigned char)(c.a * f * 3.0f); break;
+        case PARTICLE_RAIN: {
+            // thin quad from the drop back along its velocity, so it batches with everything else
+            float vx = ps->vx[i], vy = ps->vy[i];
+            float len = sqrtf(vx * vx + vy * vy) * 0.03f;
+            DrawRectanglePro((Rectangle) { x, y, s, len }, (Vector2) { s * 0.5f, 0.0f }, atan2f(vx, -vy) * RAD2DEG, c);
+            continue;
+        }
+        default: break;
+        }
+        DrawRectangleRec((Rectangle) { x - s * 0.5f, y - s * 0.5f, s, s }, c);
+    }
+    PROF_END(zone);
+}
+
+void Particles_DrawText(const Particles* ps, Camera2D cam, float alpha, float dt) {
+    PROF_ZONE(zone, "Particles_DrawText");
+    // one world-to-screen transform for all of them (the camera never rotates)
+    const float zoom = cam.zoom > 0.0f ? cam.zoom : 1.0f;
+    const float ox = cam.offset.x - cam.target.x * zoom, oy = cam.offset.y - cam.target.y * zoom;
+    const float back = (1.0f - alpha) * dt;
+
+    for (int k = 0; k < PARTICLE_TEXT_SLOTS; k++) {   // oldest first, so newer texts land on top
+        const ParticleText* t = &ps->texts[(ps->nextText + k) & (PARTICLE_TEXT_SLOTS - 1)];
+        if (t->life <= 0.0f) continue;
+        float f = t->life * (1.0f / TEXT_LIFE);
+        float age = TEXT_LIFE - t->life - back;
+        const TextLayout* text = Text_Layout(t->msg, TEXT_SIZE);
+
+        int sx = (int)(t->pos.x * zoom + ox) - text->width / 2;
+        int sy = (int)(t->pos.y * zoom + oy - 18.0f - (age > 0.0f ? age : 0.0f) * TEXT_RISE);
+        Color tint = t->color;
+        tint.a = (unsigned char)(255 * f);
+        Text_DrawLayout(text, sx + 1, sy + 1, (Color) { 0, 0, 0, (unsigned char)(180 * f) });
+        Text_DrawLayout(text, sx, sy, tint);
+    }
+    PROF_END(zone);
+}
@@ -0,0 +1,84 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+#include "raylib.h"
+#include <stdbool.h>
+#pragma once
+
+// Every short-lived effect -- rain, dust, blood and pickup sparkles -- is a
+// particle in one structure-of-arrays pool.
+// The pool is a ring in spawn order: new particles go in at the back, and
+// when it is full the front (always the oldest) is recycled. A particle that
+// dies before the ones in front of it stays as a hole until the front passes
+// it, so retiring is O(1) and nothing is ever moved. Integration is SSE/AVX
+// over the flat arrays (PARTICLES_SCALAR forces the plain loop); drawing is
+// one quad per particle from the shapes texture, so the whole pool goes out
+// in the same batch as the sprites. Floating pickup texts keep their own
+// few slots beside the pool, so a heavy rain can never recycle one.
+#define PARTICLE_CAP        (1 << 15)   // pool size, power of two
+#define PARTICLE_TEXT_SLOTS 64          // text pops alive at once; power of two
+#define PARTICLE_TEXT_LEN   16
+
+typedef enum ParticleKind {
+    PARTICLE_SPARK = 0,    // square that shrinks as it fades
+    PARTICLE_DUST,         // square that grows as it fades
+    PARTICLE_BLOOD,        // square, no fade until the last third
+    PARTICLE_RAIN,         // streak along its velocity
+    PARTICLE_KIND_COUNT
+} ParticleKind;
+
+// What an emitter spawns. Bursts (Particles_Emit) use it as a template;
+// Particles_RunEmitter also spends `rate` and keeps the fraction in `carry`.
+typedef struct ParticleEmitter {
+    ParticleKind kind;
+    Color   color;
+    float   rate;                  // per second, for Particles_RunEmitter
+    float   life, lifeJitter;      // seconds, +- jitter
+    float   speed, speedJitter;    // world units per second
+    float   angle, spread;         // heading in radians, +- spread
+    float   gravity;               // added to vy per second
+    float   size;                  // world units
+    Vector2 area;                  // spawn box half-extents around the origin
+    float   carry;                 // particles owed from the last run
+} ParticleEmitter;
+
+// A pickup text: stands still in the world, rises on screen as it fades.
+typedef struct ParticleText {
+    Vector2 pos;
+    float   life;                  // seconds left; <= 0 is free
+    Color   color;
+    char    msg[PARTICLE_TEXT_LEN];
+} ParticleText;
+
+typedef struct Particles {
+    float* x;  float* y;
+    float* vx; float* vy;
+    float* ay;                     // gravity
+    float* life;                   // seconds left; <= 0 is a hole
+    float* invLife;                // 1 / starting life, for fades
+    float* size;
+    Color* color;
+    unsigned char* kind;
+    int      first, count;         // ring [first, first + count), oldest first
+    int      alive;                // count minus holes, as of the last update
+    unsigned evicted;              // particles recycled while still alive
+    unsigned rng;                  // spread and jitter; never the gameplay RNG
+    ParticleText texts[PARTICLE_TEXT_SLOTS];   // pickup texts, reused oldest first
+    int          nextText;
+} Particles;
+
+void Particles_Init(Particles* ps, unsigned seed);
+void Particles_Free(Particles* ps);
+void Particles_Clear(Particles* ps);
+
+void Particles_Emit(Particles* ps, const ParticleEmitter* e, Vector2 at, int n);       // burst of n
+void Particles_RunEmitter(Particles* ps, ParticleEmitter* e, Vector2 at, float dt);   // e->rate * dt, carried
+void Particles_AddText(Particles* ps, Vector2 at, Color color, const char* msg);
+void Particles_Update(Particles* ps, float dt);
+
+// alpha is the render position between the last two updates of dt seconds.
+// Particles_Draw goes inside BeginMode2D and skips text; Particles_DrawText
+// draws only text, in screen space through cam.
+void Particles_Draw(const Particles* ps, Rectangle view, float alpha, float dt);
+void Particles_DrawText(const Particles* ps, Camera2D cam, float alpha, float dt);
+
+#endif
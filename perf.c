@@ -0,0 +1,27 @@
+#include "perf.h"
+
+static int BucketOf(float ms) {
+    int b = (int)(ms / PERF_BUCKET_MS);
+    if (b < 0) b = 0;
+    if (b >= PERF_BUCKETS) b = PERF_BUCKETS - 1;
+    return b;
+}
+
+void FrameStats_Add(FrameStats* s, float ms) {
+    if (s->count == PERF_FRAMES) s->hist[BucketOf(s->ms[s->next])]--;
+    else s->count++;
+    s->ms[s->next] = ms;
+    s->hist[BucketOf(ms)]++;
+    s->next = (s->next + 1) % PERF_FRAMES;
+}
+
+float FrameStats_Percentile(const FrameStats* s, float p) {
+    if (s->count == 0) return 0.0f;
+    int rank = (int)(p * (float)(s->count - 1) + 0.5f);   // 0-based sample rank
+    int seen = 0;
+    for (int b = 0; b < PERF_BUCKETS; b++) {
+        seen += s->hist[b];
+        if (seen > rank) return (b + 0.5f) * PERF_BUCKET_MS;
+    }
+    return PERF_BUCKETS * PERF_BUCKET_MS;
+}
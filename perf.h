@@ -0,0 +1,22 @@
+#ifndef PERF_H
+#define PERF_H
+#pragma once
+
+// Rolling frame-time record behind the F3 perf overlay. Each sample goes into
+// a ring (for the graph) and a fixed-width histogram (for percentiles); the
+// sample it replaces leaves both, so a percentile is one pass over
+// PERF_BUCKETS counters, never a sort.
+#define PERF_FRAMES     240      // graph length: 4 s at 60 fps
+#define PERF_BUCKET_MS  0.1f     // histogram resolution
+#define PERF_BUCKETS    500      // 0..50 ms; slower frames land in the last bucket
+
+typedef struct FrameStats {
+    float          ms[PERF_FRAMES];   // ring, oldest at `next` once full
+    int            next, count;
+    unsigned short hist[PERF_BUCKETS];
+} FrameStats;
+
+void  FrameStats_Add(FrameStats* s, float ms);
+float FrameStats_Percentile(const FrameStats* s, float p);   // p in 0..1; 0 with no samples
+
+#endif
@@ -4,10 +4,14 @@
 #include "game.h"
 #include "assets.h"
 #include "world.h"    
+#include "audio.h"
+#include "profile.h"
 
+// The world is streamed, so the only hard edge is the float-precision limit;
+// Player_Update also refuses to step into a chunk that isn't resident.
 static void ClampToWorld(Vector2* p) {
-    if (p->x < 0) p->x = 0; if (p->y < 0) p->y = 0;
-    if (p->x > WORLD_W) p->x = WORLD_W; if (p->y > WORLD_H) p->y = WORLD_H;
+    if (p->x < -WORLD_LIMIT) p->x = -WORLD_LIMIT; if (p->y < -WORLD_LIMIT) p->y = -WORLD_LIMIT;
+    if (p->x > WORLD_LIMIT) p->x = WORLD_LIMIT; if (p->y > WORLD_LIMIT) p->y = WORLD_LIMIT;
 }
 
 Player* Player_Create(Vector2 spawn) {
@@ -28,48 +32,47 @@ Player* Player_Create(Vector2 spawn) {
 void Player_Destroy(Player* p) { MemFree(p); }
 
 // Gather items / drink / inspect clue when near and pressing E
-// Gather items / drink / inspect clue when near and pressing E
+// Acts on g->nearNode, the same node the context prompt is showing.
 static void Gather(Game* g, Player* p) {
-    for (int i = 0; i < g->nodeCount; ++i) {
-        Node* n = &g->nodes[i];
-
-        if ((n->type == NODE_BERRY || n->type == NODE_STICK || n->type == NODE_CLUE) && n->taken)
-            continue;
-
-        // interaction radius scaled up to match larger world objects
-        float r = ((n->type == NODE_POND) ? 48.0f :
-            (n->type == NODE_CLUE) ? 36.0f : 24.0f) * 1.8f;
-
-        if (Vector2Distance(p->pos, n->pos) > r) continue;
-
-        switch (n->type) {
-        case NODE_BERRY:
-            p->invFood++; n->taken = true;
-            Game_AddPop(g, n->pos, (Color) { 230, 80, 90, 255 }, "+Food");
-            PlaySound(g->assets->sPickupFood);
-            break;
-
-        case NODE_STICK:
-            p->invStick++; n->taken = true;
-            Game_AddPop(g, n->pos, (Color) { 160, 120, 80, 255 }, "+Stick");
-            PlaySound(g->assets->sPickupStick);
-            break;
-
-        case NODE_POND:
-            p->invWater++;
-            Game_AddPop(g, n->pos, (Color) { 60, 150, 230, 255 }, "+Water");
-            PlaySound(g->assets->sDrink);
-            break;
-
-        case NODE_CLUE:
-            n->taken = true; g->cluesCollected++;
-            Game_AddPop(g, n->pos, (Color) { 255, 220, 80, 255 }, "Clue!");
-            PlaySound(g->assets->sClue);
-            break;
-
-        default: break;
-        }
-        break; // handle one thing per press
+    if (g->nearNode == NODE_NONE) return;
+    NodeId  id = g->nearNode;
+    Vector2 at = Nodes_Pos(&g->nodes, id);
+    bool    take = true;
+
+    switch (Nodes_Type(&g->nodes, id)) {
+    case NODE_BERRY:
+        p->invFood++;
+        Game_AddPop(g, at, (Color) { 230, 80, 90, 255 }, "+Food");
+        Audio_PlaySfx(SFX_PICKUP_FOOD);
+        break;
+
+    case NODE_STICK:
+        p->invStick++;
+        Game_AddPop(g, at, (Color) { 160, 120, 80, 255 }, "+Stick");
+        Audio_PlaySfx(SFX_PICKUP_STICK);
+        break;
+
+    case NODE_POND:
+        p->invWater++; take = false;   // ponds never run dry
+        Game_AddPop(g, at, (Color) { 60, 150, 230, 255 }, "+Water");
+        Audio_PlaySfx(SFX_DRINK);
+        break;
+
+    case NODE_CLUE:
+        g->cluesCollected++;
+        Game_AddPop(g, at, (Color) { 255, 220, 80, 255 }, "Clue!");
+        Audio_PlaySfx(SFX_CLUE);
+        break;
+
+    default: take = false; break;
+    }
+
+    // taken pickups leave the index; refresh so the prompt doesn't show a stale node
+    if (take) {
+        World_OnTaken(g->world, &g->nodes, id);
+        Minimap_OnTaken(&g->map, at);
+        Nodes_Take(&g->nodes, id);
+        g->nearNode = Nodes_FindInteractable(&g->nodes, p->pos);
     }
 }
 
@@ -79,7 +82,7 @@ static void Craft(Player* p, Game* g) {
         p->invStick -= 2;
         p->hasSpear = true;
         Game_AddPop(g, p->pos, (Color) { 220, 220, 150, 255 }, "Spear!");
-        PlaySound(g->assets->sCraft);
+        Audio_PlaySfx(SFX_CRAFT);
     }
 }
 
@@ -88,24 +91,34 @@ static void Eat(Player* p) { if (p->invFood > 0 && p->hunger < 100) { p->invFood
 static void Drink(Player* p) { if (p->invWater > 0 && p->thirst < 100) { p->invWater--; p->thirst += 45; if (p->thirst > 100)p->thirst = 100; } }
 
 void Player_Update(Player* p, Game* g, float dt) {
+    PROF_ZONE(zone, "Player_Update");
     // --- needs drain ---
     float heat = (g->timeOfDay < 0.45f) ? 1.1f : 0.9f;
     float radius = p->baseRadius * p->scale;
     p->hunger -= 2.0f * dt;
     p->thirst -= 3.0f * dt * heat;
     if (p->hunger <= 0 || p->thirst <= 0) {
-        p->hp -= (p->hunger <= 0 && p->thirst <= 0) ? 2 : 1;
+        // damage on a timer, not per tick, so it doesn't depend on the tick rate
+        p->starveTimer += dt;
+        while (p->starveTimer >= STARVE_INTERVAL) {
+            p->starveTimer -= STARVE_INTERVAL;
+            p->hp -= (p->hunger <= 0 && p->thirst <= 0) ? 2 : 1;
+        }
         if (p->hp < 0) p->hp = 0;
         if (p->hunger < 0) p->hunger = 0;
         if (p->thirst < 0) p->thirst = 0;
     }
+    else {
+        p->starveTimer = 0.0f;
+    }
 
     // --- input: build raw WASD vector ---
     Vector2 a = (Vector2){ 0.0f, 0.0f };  // < THIS must exist
-    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP))    a.y -= 1.0f;
-    if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN))  a.y += 1.0f;
-    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT))  a.x -= 1.0f;
-    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) a.x += 1.0f;
+    const Input* in = &g->input;
+    if (Input_Down(in, BTN_UP))    a.y -= 1.0f;
+    if (Input_Down(in, BTN_DOWN))  a.y += 1.0f;
+    if (Input_Down(in, BTN_LEFT))  a.x -= 1.0f;
+    if (Input_Down(in, BTN_RIGHT)) a.x += 1.0f;
 
     // --- 4-way facing from raw WASD (before normalize) ---
     if (a.x != 0.0f || a.y != 0.0f) {
@@ -117,7 +130,7 @@ void Player_Update(Player* p, Game* g, float dt) {
         }
     }
 
-    if (IsKeyPressed(KEY_F)) Craft(p, g);
+    if (Input_Pressed(in, BTN_CRAFT)) Craft(p, g);
 
     // --- acceleration from input (normalized) ---
     if (a.x != 0.0f || a.y != 0.0f) {
@@ -135,7 +148,7 @@ void Player_Update(Player* p, Game* g, float dt) {
     p->vel.y *= damp;
 
     // sprint + top speed
-    float run = IsKeyDown(KEY_LEFT_SHIFT) ? 1.5f : 1.0f;
+    float run = Input_Down(in, BTN_SPRINT) ? 1.5f : 1.0f;
     p->maxSpeed = 300.0f * run;
 
     float sp = Vector2Length(p->vel);
@@ -144,22 +157,31 @@ void Player_Update(Player* p, Game* g, float dt) {
     }
 
     // apply to position
+    Vector2 prev = p->pos;
     p->pos.x += p->vel.x * dt;
     p->pos.y += p->vel.y * dt;
 
     // keep mouse aim if you still use p->facing elsewhere
-    Vector2 mouseWorld = GetScreenToWorld2D(GetMousePosition(), g->cam);
+    Vector2 mouseWorld = GetScreenToWorld2D(in->mouse, g->cam);
     Vector2 aim = Vector2Subtract(mouseWorld, p->pos);
     if (Vector2LengthSqr(aim) > 0.001f) p->facing = atan2f(aim.y, aim.x);
 
     ClampToWorld(&p->pos);
+    if (!World_IsLoaded(g->world, p->pos)) {   // chunk not streamed in (budget exhausted)
+        p->pos = prev;
+        p->vel = (Vector2){ 0.0f, 0.0f };
+    }
+
+    // nearest interactable, shared by Gather() and the UI prompt
+    g->nearNode = Nodes_FindInteractable(&g->nodes, p->pos);
 
     // interactions
-    if (IsKeyPressed(KEY_E))   Gather(g, p);
-    if (IsKeyPressed(KEY_ONE)) Eat(p);
-    if (IsKeyPressed(KEY_TWO)) Drink(p);
+    if (Input_Pressed(in, BTN_GATHER)) Gather(g, p);
+    if (Input_Pressed(in, BTN_EAT))    Eat(p);
+    if (Input_Pressed(in, BTN_DRINK))  Drink(p);
 
     if (p->attackCooldown > 0.0f) p->attackCooldown -= dt;
+    PROF_END(zone);
 }
 
 
@@ -170,18 +192,17 @@ void Player_Draw(const Player* p, const struct Assets* assets) {
         Fade(BLACK, 0.25f));
     
 
-    Texture2D tex = assets->texPlayerDown;
-    if (p->dir4 == 1) tex = assets->texPlayerLeft;
-    else if (p->dir4 == 2) tex = assets->texPlayerRight;
-    else if (p->dir4 == 3) tex = assets->texPlayerUp;
+    Sprite spr = assets->sprPlayerDown;
+    if (p->dir4 == 1) spr = assets->sprPlayerLeft;
+    else if (p->dir4 == 2) spr = assets->sprPlayerRight;
+    else if (p->dir4 == 3) spr = assets->sprPlayerUp;
 
 
 
-    Rectangle src = (Rectangle){ 0.0f, 0.0f, (float)tex.width, (float)tex.height };
     Rectangle dst = (Rectangle){ p->pos.x, p->pos.y, 24.0f * p->scale, 24.0f * p->scale };
     Vector2   origin = (Vector2){ 12.0f * p->scale, 12.0f * p->scale };
 
-    DrawTexturePro(tex, src, dst, origin, 0.0f, WHITE);
+    Assets_DrawSprite(spr, dst, origin, 0.0f, WHITE);
 
     // optional spear overlay
     if (p->hasSpear) {
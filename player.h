@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #pragma once
 
+#define STARVE_INTERVAL 1.0f   // seconds between HP losses while starving or parched
+
 struct Game;
 struct Assets;
 
@@ -21,6 +23,7 @@ typedef struct Player {
     float hunger;              // 0..100
     float thirst;              // 0..100
     float attackCooldown;
+    float starveTimer;         // time accumulated toward the next starvation hit
     float   facing;
     float scale;
     float baseRadius;
@@ -0,0 +1,98 @@
+#include "post.h"
+#include "assets.h"    // Assets_Begin*/End*
+#include "profile.h"
+
+// raylib's default vertex shader feeds fragTexCoord; only the fragment stage
+// is ours. GLSL ES 1.0 where raylib runs on GLES2, 3.30 on desktop GL.
+#if defined(PLATFORM_ANDROID) || defined(PLATFORM_WEB) || defined(GRAPHICS_API_OPENGL_ES2)
+#define POST_GLSL_HEADER \
+    "#version 100\n" \
+    "precision mediump float;\n" \
+    "#define IN varying\n" \
+    "#define TEX texture2D\n" \
+    "#define OUT gl_FragColor\n"
+#else
+#define POST_GLSL_HEADER \
+    "#version 330\n" \
+    "#define IN in\n" \
+    "#define TEX texture\n" \
+    "out vec4 finalColor;\n" \
+    "#define OUT finalColor\n"
+#endif
+
+// Same maths as the passes it replaces: multiply by the lightmap, darken by
+// half the vignette and then toward the edges (0.8 at max(w, h) from the
+// centre), blend the flash colour over the result.
+static const char* kFragment = POST_GLSL_HEADER
+    "IN vec2 fragTexCoord;\n"
+    "IN vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"     // scene
+    "uniform sampler2D lightMap;\n"
+    "uniform vec2  lightScale;\n"
+    "uniform float lightOn;\n"
+    "uniform float vignette;\n"
+    "uniform vec2  screen;\n"
+    "uniform vec4  flash;\n"
+    "void main() {\n"
+    "    vec2 uv = vec2(fragTexCoord.x, 1.0 - fragTexCoord.y);\n"   // render textures are bottom-up
+    "    vec3 c = TEX(texture0, fragTexCoord).rgb;\n"
+    "    if (lightOn > 0.5) c *= TEX(lightMap, uv * lightScale).rgb;\n"
+    "    float r = min(length((uv - 0.5) * screen) / max(screen.x, screen.y), 1.0);\n"
+    "    c *= (1.0 - 0.5 * vignette) * (1.0 - 0.8 * vignette * r);\n"
+    "    OUT = vec4(mix(c, flash.rgb, flash.a), 1.0);\n"
+    "}\n";
+
+static void Setup(PostFx* p) {
+    p->tried = true;
+    if (p->disabled) return;
+    p->shader = LoadShaderFromMemory(NULL, kFragment);
+    // a failed compile hands back raylib's default shader, which has none of our uniforms
+    p->locLight = GetShaderLocation(p->shader, "lightMap");
+    p->locLightScale = GetShaderLocation(p->shader, "lightScale");
+    p->locLightOn = GetShaderLocation(p->shader, "lightOn");
+    p->locVignette = GetShaderLocation(p->shader, "vignette");
+    p->locScreen = GetShaderLocation(p->shader, "screen");
+    p->locFlash = GetShaderLocation(p->shader, "flash");
+    p->ready = p->shader.id != 0 && p->locLight >= 0 && p->locFlash >= 0;
+    if (!p->ready) TraceLog(LOG_WARNING, "POST: compositor shader unavailable, drawing overlays as separate passes");
+}
+
+void PostFx_Free(PostFx* p) {
+    if (p->ready) UnloadShader(p->shader);
+    if (p->scene.id) UnloadRenderTexture(p->scene);
+    bool disabled = p->disabled;
+    *p = (PostFx){ 0 };
+    p->disabled = disabled;
+}
+
+bool PostFx_Begin(PostFx* p, int screenW, int screenH) {
+    if (!p->tried) Setup(p);
+    if (!p->ready) return false;
+    if (p->scene.id == 0 || p->scene.texture.width != screenW || p->scene.texture.height != screenH) {
+        if (p->scene.id) UnloadRenderTexture(p->scene);
+        p->scene = LoadRenderTexture(screenW, screenH);
+        if (p->scene.id == 0) return false;   // try again next frame; this one takes the fallback
+    }
+    Assets_BeginTextureMode(p->scene);
+    return true;
+}
+
+void PostFx_End(PostFx* p, const PostParams* params) {
+    Assets_EndTextureMode();
+    PROF_ZONE(zone, "PostFx_End");
+    float w = (float)p->scene.texture.width, h = (float)p->scene.texture.height;
+    float lightOn = params->light.id ? 1.0f : 0.0f;
+    float screen[2] = { w, h };
+    float flash[4] = { params->flash.r / 255.0f, params->flash.g / 255.0f, params->flash.b / 255.0f, params->flash.a / 255.0f };
+
+    Assets_BeginShaderMode(p->shader);
+    if (params->light.id) SetShaderValueTexture(p->shader, p->locLight, params->light);
+    SetShaderValue(p->shader, p->locLightScale, &params->lightScale, SHADER_UNIFORM_VEC2);
+    SetShaderValue(p->shader, p->locLightOn, &lightOn, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(p->shader, p->locVignette, &params->vignette, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(p->shader, p->locScreen, screen, SHADER_UNIFORM_VEC2);
+    SetShaderValue(p->shader, p->locFlash, flash, SHADER_UNIFORM_VEC4);
+    DrawTextureRec(p->scene.texture, (Rectangle) { 0, 0, w, -h }, (Vector2) { 0, 0 }, WHITE);
+    Assets_EndShaderMode();
+    PROF_END(zone);
+}
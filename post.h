@@ -0,0 +1,34 @@
+#ifndef POST_H
+#define POST_H
+#include "raylib.h"
+#include <stdbool.h>
+#pragma once
+
+// Full-screen compositor. The world is drawn once into a render texture, and
+// one shaded quad writes it to the screen with every screen-wide effect
+// applied: the lightmap multiply, an optional vignette and the hit flash.
+// That replaces a stack of alpha-blended full-screen passes, which cost
+// fill rate on low-end and software GL. Where the shader or render target
+// can't be made (GL 1.1, a GLSL compile failure, --no-post), PostFx_Begin
+// returns false and the caller draws the old passes instead.
+typedef struct PostParams {
+    Texture2D light;        // lightmap, id 0 = no lighting this frame
+    Vector2   lightScale;   // screen size over the pixels the lightmap covers
+    float     vignette;     // 0..1 darkening toward the edges, 0 = off
+    Color     flash;        // alpha = strength
+} PostParams;
+
+typedef struct PostFx {
+    Shader          shader;
+    int             locLight, locLightScale, locLightOn, locVignette, locScreen, locFlash;
+    RenderTexture2D scene;
+    bool            tried;     // setup attempted (it needs a window, so it waits for the first frame)
+    bool            ready;
+    bool            disabled;  // forced off: always the fallback
+} PostFx;
+
+void PostFx_Free(PostFx* p);
+bool PostFx_Begin(PostFx* p, int screenW, int screenH);   // true: draw the world now, into the scene
+void PostFx_End(PostFx* p, const PostParams* params);      // composite to the screen
+
+#endif
@@ -0,0 +1,187 @@
+#include "profile.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PROF_THREAD_LOCAL __declspec(thread)
+static long AtomicFetchAdd(volatile long* v) { return _InterlockedExchangeAdd(v, 1); }
+// x86/x64 only: plain loads and stores already acquire/release, so only the compiler needs holding
+static unsigned LoadAcquire(volatile unsigned* p)            { unsigned v = *p; _ReadWriteBarrier(); return v; }
+static void     StoreRelease(volatile unsigned* p, unsigned v) { _ReadWriteBarrier(); *p = v; }
+static void     FenceAcquire(void)                           { _ReadWriteBarrier(); }
+#else
+#define PROF_THREAD_LOCAL _Thread_local
+static long AtomicFetchAdd(volatile long* v) { return __atomic_fetch_add(v, 1, __ATOMIC_ACQ_REL); }
+static unsigned LoadAcquire(volatile unsigned* p)            { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static void     StoreRelease(volatile unsigned* p, unsigned v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+static void     FenceAcquire(void)                           { __atomic_thread_fence(__ATOMIC_ACQUIRE); }
+#endif
+
+typedef struct ProfEvent {
+    const char* name;
+    double      start, end;
+} ProfEvent;
+
+// One per thread, written only by its owner. `head` counts every event ever
+// recorded; the ring keeps the last PROF_RING_EVENTS of them. An event is
+// written first and then published by a release store of head, so a reader
+// that acquires head sees every event below it complete -- until the owner
+// laps the ring and starts overwriting them. The ring itself is published the
+// same way: events and name are set before the release store of `ready`, and
+// neither changes after it.
+typedef struct ProfRing {
+    ProfEvent*        events;
+    volatile unsigned head;
+    volatile unsigned ready;
+    char              name[32];
+} ProfRing;
+
+bool prof_recording = false;
+
+static ProfRing      rings[PROF_MAX_THREADS];
+static volatile long ringCount;
+static PROF_THREAD_LOCAL ProfRing* tlsRing;
+static PROF_THREAD_LOCAL bool      tlsFull;   // registration failed: drop this thread's zones
+
+static double epoch;          // trace timestamps are relative to this
+
+// frame bookkeeping, main thread only
+static int    frame = -1;
+static double frameStart;
+static int    rangeFirst = -1, rangeLast = -1;
+static double rangeStart;
+static char   rangePath[256];
+static double stutterSeconds; // 0 = off
+static bool   triggered;
+
+// name NULL: "main" for the first thread, "thread <n>" after that
+static ProfRing* ThreadRing(const char* name) {
+    if (tlsRing || tlsFull) return tlsRing;
+    long slot = AtomicFetchAdd(&ringCount);
+    if (slot >= PROF_MAX_THREADS) { tlsFull = true; return NULL; }
+    ProfRing* r = &rings[slot];
+    r->events = MemAlloc(PROF_RING_EVENTS * sizeof(ProfEvent));
+    if (name) snprintf(r->name, sizeof(r->name), "%s", name);
+    else if (slot == 0) snprintf(r->name, sizeof(r->name), "main");
+    else snprintf(r->name, sizeof(r->name), "thread %ld", slot);
+    StoreRelease(&r->ready, 1);
+    tlsRing = r;
+    return r;
+}
+
+void Prof_SetRecording(bool on) {
+    if (on && epoch == 0.0) epoch = Timer_Now();
+    prof_recording = on;
+}
+
+// Only before the thread's first zone: once published, the name is read
+// unlocked by Prof_Dump.
+void Prof_SetThreadName(const char* name) {
+    ThreadRing(name);
+}
+
+void Prof_Record(const char* name, double start, double end) {
+    ProfRing* r = ThreadRing(NULL);
+    if (!r) return;
+    unsigned head = r->head;   // only this thread stores it
+    ProfEvent* e = &r->events[head & (PROF_RING_EVENTS - 1)];
+    e->name = name;
+    e->start = start;
+    e->end = end;
+    StoreRelease(&r->head, head + 1);
+}
+
+// -----------------------------------------------------------------------------
+// Chrome trace-event JSON: one complete ("X") event per zone, timestamps in
+// microseconds. Zones on the same thread nest by time, so no begin/end pairing
+// is needed. A ring that wrapped past `since` is written as far back as it goes.
+bool Prof_Dump(const char* path, double since) {
+    FILE* f = fopen(path, "wb");
+    if (!f) { TraceLog(LOG_ERROR, "PROF: cannot create %s", path); return false; }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    int written = 0;
+    ProfEvent* copy = MemAlloc(PROF_RING_EVENTS * sizeof(ProfEvent));
+    for (int t = 0; t < PROF_MAX_THREADS; t++) {
+        ProfRing* r = &rings[t];
+        if (!LoadAcquire(&r->ready)) continue;   // unclaimed, or still being set up
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",\n", t, r->name);
+        first = false;
+
+        // copy what is published, then drop whatever the owner may have
+        // overwritten meanwhile: every event up to the one it is writing now
+        unsigned head = LoadAcquire(&r->head);
+        unsigned n = head < PROF_RING_EVENTS ? head : PROF_RING_EVENTS;
+        for (unsigned k = head - n; k != head; k++) copy[k & (PROF_RING_EVENTS - 1)] = r->events[k & (PROF_RING_EVENTS - 1)];
+        FenceAcquire();
+        unsigned now = LoadAcquire(&r->head);
+        unsigned span = now + 1 - (head - n);   // events from the oldest copy to the one in flight
+        unsigned lost = span > PROF_RING_EVENTS ? span - PROF_RING_EVENTS : 0;
+        if (lost > n) lost = n;
+        unsigned oldest = head - n + lost;
+
+        bool truncated = (n == PROF_RING_EVENTS || lost > 0) &&
+            (oldest == head || copy[oldest & (PROF_RING_EVENTS - 1)].start > since);
+        if (truncated) TraceLog(LOG_WARNING, "PROF: %s ring wrapped, trace starts late", r->name);
+        for (unsigned k = oldest; k != head; k++) {
+            const ProfEvent* e = &copy[k & (PROF_RING_EVENTS - 1)];
+            if (e->start < since) continue;
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                e->name, t, (e->start - epoch) * 1e6, (e->end - e->start) * 1e6);
+            written++;
+        }
+    }
+    MemFree(copy);
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    TraceLog(LOG_INFO, "PROF: wrote %d zones to %s", written, path);
+    return true;
+}
+
+void Prof_CaptureFrames(int first, int last, const char* path) {
+    rangeFirst = first;
+    rangeLast = last;
+    snprintf(rangePath, sizeof(rangePath), "%s", path);
+    Prof_SetRecording(true);
+}
+
+void Prof_CaptureOnStutter(double frameMs) {
+    stutterSeconds = frameMs * 1e-3;
+    Prof_SetRecording(true);
+}
+
+void Prof_Trigger(void) {
+    triggered = true;
+    Prof_SetRecording(true);
+}
+
+void Prof_FrameMark(void) {
+    double now = Timer_Now();
+    char path[64];
+
+    // the frame that just ended
+    if (frame >= 0) {
+        if (frame == rangeLast && rangeFirst >= 0) {
+            Prof_Dump(rangePath, rangeStart);
+            rangeFirst = rangeLast = -1;
+        }
+        if (stutterSeconds > 0.0 && now - frameStart > stutterSeconds) {
+            TraceLog(LOG_WARNING, "PROF: frame %d took %.1f ms", frame, (now - frameStart) * 1e3);
+            snprintf(path, sizeof(path), "trace_stutter_%d.json", frame);
+            Prof_Dump(path, now - PROF_HISTORY);
+        }
+        if (triggered) {
+            snprintf(path, sizeof(path), "trace_%d.json", frame);
+            Prof_Dump(path, now - PROF_HISTORY);
+            triggered = false;
+        }
+    }
+
+    frame++;
+    frameStart = Timer_Now();   // a dump above is not the next frame's time
+    if (frame == rangeFirst) rangeStart = frameStart;
+}
@@ -0,0 +1,61 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+#include "timer.h"
+#include <stdbool.h>
+#pragma once
+
+// Scoped-zone profiler for finding where a frame goes. Each thread writes
+// finished zones into its own ring buffer (no locks, no allocation on the hot
+// path); a capture writes them out as Chrome trace-event JSON, which opens in
+// chrome://tracing or ui.perfetto.dev. While recording is off a zone costs one
+// predictable branch; building with SO_NO_PROFILE compiles zones out entirely.
+//
+//     PROF_ZONE(z, "Game_Update");
+//     ...                             // every path out must reach PROF_END
+//     PROF_END(z);
+//
+// Captures: a frame range (Prof_CaptureFrames), the last second of history on
+// demand (Prof_Trigger, F4 in game), or automatically when a frame overruns
+// (Prof_CaptureOnStutter).
+#define PROF_RING_EVENTS  (1 << 15)   // per thread, power of two
+#define PROF_MAX_THREADS  16
+#define PROF_HISTORY      1.0         // seconds written by a trigger or stutter capture
+
+typedef struct ProfZone {
+    const char* name;      // string literal: only the pointer is stored
+    double      start;     // 0 when recording was off at the start
+} ProfZone;
+
+extern bool prof_recording;
+
+void Prof_SetRecording(bool on);
+void Prof_SetThreadName(const char* name);   // label for this thread's track; before its first zone
+void Prof_Record(const char* name, double start, double end);
+
+// Call once per frame (or tick, headless), first thing. Frames are numbered
+// from 0 by these calls; scheduled and stutter captures are written here.
+void Prof_FrameMark(void);
+void Prof_CaptureFrames(int first, int last, const char* path);
+void Prof_CaptureOnStutter(double frameMs);   // writes trace_stutter_<frame>.json
+void Prof_Trigger(void);                      // writes trace_<frame>.json at the next mark
+bool Prof_Dump(const char* path, double since); // zones that started at or after `since`
+
+static inline ProfZone Prof_Begin(const char* name) {
+    ProfZone z = { name, 0.0 };
+    if (prof_recording) z.start = Timer_Now();
+    return z;
+}
+
+static inline void Prof_End(ProfZone z) {
+    if (prof_recording && z.start != 0.0) Prof_Record(z.name, z.start, Timer_Now());
+}
+
+#ifdef SO_NO_PROFILE
+#define PROF_ZONE(var, name) ((void)0)
+#define PROF_END(var)        ((void)0)
+#else
+#define PROF_ZONE(var, name) ProfZone var = Prof_Begin(name)
+#define PROF_END(var)        Prof_End(var)
+#endif
+
+#endif
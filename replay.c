@@ -0,0 +1,143 @@
+#include "replay.h"
+#include "game.h"
+#include "raylib.h"
+#include <string.h>
+
+#define REPLAY_VERSION 3
+#define HEADER_BYTES   20
+#define RUN_BYTES      20
+
+// --- little-endian field io ---
+static void PutU32(unsigned char* b, unsigned v) { b[0] = (unsigned char)v; b[1] = (unsigned char)(v >> 8); b[2] = (unsigned char)(v >> 16); b[3] = (unsigned char)(v >> 24); }
+static void PutU16(unsigned char* b, unsigned v) { b[0] = (unsigned char)v; b[1] = (unsigned char)(v >> 8); }
+static unsigned GetU32(const unsigned char* b) { return b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned)b[3] << 24); }
+static unsigned GetU16(const unsigned char* b) { return b[0] | (b[1] << 8); }
+static void PutF32(unsigned char* b, float f) { unsigned v; memcpy(&v, &f, 4); PutU32(b, v); }
+static float GetF32(const unsigned char* b) { unsigned v = GetU32(b); float f; memcpy(&f, &v, 4); return f; }
+
+static bool SameInput(const Input* a, const Input* b) {
+    return a->down == b->down && a->pressed == b->pressed &&
+           memcmp(&a->mouse, &b->mouse, sizeof(a->mouse)) == 0 &&
+           a->screenW == b->screenW && a->screenH == b->screenH;
+}
+
+static void WriteRun(Replay* r) {
+    unsigned char b[RUN_BYTES];
+    PutU32(b, r->runLeft);
+    PutU16(b + 4, r->run.down);
+    PutU16(b + 6, r->run.pressed);
+    PutF32(b + 8, r->run.mouse.x);
+    PutF32(b + 12, r->run.mouse.y);
+    PutU16(b + 16, (unsigned)r->run.screenW);
+    PutU16(b + 18, (unsigned)r->run.screenH);
+    fwrite(b, 1, sizeof(b), r->file);
+}
+
+bool Replay_BeginRecord(Replay* r, const char* path, unsigned seed, int hordeSize) {
+    *r = (Replay){ 0 };
+    r->file = fopen(path, "wb");
+    if (!r->file) { TraceLog(LOG_ERROR, "REPLAY: cannot create %s", path); return false; }
+
+    unsigned char h[HEADER_BYTES];
+    memcpy(h, "SORP", 4);
+    PutU32(h + 4, REPLAY_VERSION);
+    PutU32(h + 8, seed);
+    PutU32(h + 12, SIM_HZ);
+    PutU32(h + 16, (unsigned)hordeSize);
+    fwrite(h, 1, sizeof(h), r->file);
+
+    r->mode = REPLAY_RECORD;
+    r->seed = seed;
+    r->hordeSize = hordeSize;
+    TraceLog(LOG_INFO, "REPLAY: recording to %s (seed %u)", path, seed);
+    return true;
+}
+
+bool Replay_BeginPlayback(Replay* r, const char* path) {
+    *r = (Replay){ 0 };
+    r->file = fopen(path, "rb");
+    if (!r->file) { TraceLog(LOG_ERROR, "REPLAY: cannot open %s", path); return false; }
+
+    unsigned char h[HEADER_BYTES];
+    if (fread(h, 1, sizeof(h), r->file) != sizeof(h) || memcmp(h, "SORP", 4) != 0 ||
+        GetU32(h + 4) != REPLAY_VERSION || GetU32(h + 12) != SIM_HZ) {
+        TraceLog(LOG_ERROR, "REPLAY: %s is not a compatible replay", path);
+        fclose(r->file);
+        r->file = NULL;
+        return false;
+    }
+
+    r->mode = REPLAY_PLAY;
+    r->seed = GetU32(h + 8);
+    r->hordeSize = (int)GetU32(h + 16);
+    TraceLog(LOG_INFO, "REPLAY: playing %s (seed %u)", path, r->seed);
+    return true;
+}
+
+bool Replay_Tick(Replay* r, Input* in) {
+    if (r->mode == REPLAY_RECORD) {
+        if (r->runLeft > 0 && !SameInput(&r->run, in)) {
+            WriteRun(r);
+            r->runLeft = 0;
+        }
+        if (r->runLeft == 0) r->run = *in;
+        r->runLeft++;
+        r->ticks++;
+        return true;
+    }
+
+    if (r->mode != REPLAY_PLAY) return true;
+
+    while (r->runLeft == 0) {
+        unsigned char b[RUN_BYTES];
+        if (fread(b, 1, 4, r->file) != 4) return false;        // truncated log: stop here
+        unsigned count = GetU32(b);
+        if (count == 0) {                                       // footer
+            if (fread(b, 1, 8, r->file) == 8) {
+                r->endTicks = GetU32(b);
+                r->endChecksum = GetU32(b + 4);
+            }
+            return false;
+        }
+        if (fread(b + 4, 1, RUN_BYTES - 4, r->file) != RUN_BYTES - 4) return false;
+        r->run = (Input){
+            .down = GetU16(b + 4),
+            .pressed = GetU16(b + 6),
+            .mouse = { GetF32(b + 8), GetF32(b + 12) },
+            .screenW = (int)GetU16(b + 16),
+            .screenH = (int)GetU16(b + 18),
+        };
+        r->runLeft = count;
+    }
+
+    *in = r->run;
+    r->runLeft--;
+    r->ticks++;
+    return true;
+}
+
+void Replay_End(Replay* r, unsigned checksum) {
+    if (!r->file) return;
+
+    if (r->mode == REPLAY_RECORD) {
+        if (r->runLeft > 0) WriteRun(r);
+        unsigned char b[12];
+        PutU32(b, 0);
+        PutU32(b + 4, r->ticks);
+        PutU32(b + 8, checksum);
+        fwrite(b, 1, sizeof(b), r->file);
+        TraceLog(LOG_INFO, "REPLAY: recorded %u ticks (checksum %08x)", r->ticks, checksum);
+    }
+    else if (r->mode == REPLAY_PLAY) {
+        if (r->ticks != r->endTicks)
+            TraceLog(LOG_INFO, "REPLAY: stopped after %u of %u ticks", r->ticks, r->endTicks);
+        else if (checksum == r->endChecksum)
+            TraceLog(LOG_INFO, "REPLAY: %u ticks, in sync (checksum %08x)", r->ticks, checksum);
+        else
+            TraceLog(LOG_WARNING, "REPLAY: DESYNC after %u/%u ticks (checksum %08x, recorded %08x)",
+                r->ticks, r->endTicks, checksum, r->endChecksum);
+    }
+
+    fclose(r->file);
+    *r = (Replay){ 0 };
+}
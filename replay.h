@@ -0,0 +1,45 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+#include "input.h"
+#include <stdio.h>
+#include <stdbool.h>
+#pragma once
+
+// Session log: the RNG seed and horde size plus the Input of every simulation tick,
+// run-length encoded (identical consecutive ticks share one record).
+// Feeding it back through Game_Frame replays the session bit for bit.
+//
+// File layout (little-endian):
+//   header  "SORP", u32 version, u32 seed, u32 ticks per second, u32 horde size
+//   runs    u32 count, u16 down, u16 pressed, f32 mouse x/y, u16 screen w/h
+//   footer  u32 0, u32 ticks, u32 Game_Checksum() after the last tick
+typedef enum ReplayMode {
+    REPLAY_OFF = 0,
+    REPLAY_RECORD,
+    REPLAY_PLAY
+} ReplayMode;
+
+typedef struct Replay {
+    FILE*      file;
+    ReplayMode mode;
+    unsigned   seed;
+    int        hordeSize;   // Game.hordeSize the session started with
+    unsigned   ticks;       // ticks recorded / played so far
+    Input      run;         // input of the current run
+    unsigned   runLeft;     // play: ticks left in the run; record: ticks in it
+    unsigned   endTicks;    // play: tick count from the footer
+    unsigned   endChecksum; // play: checksum from the footer
+} Replay;
+
+bool Replay_BeginRecord(Replay* r, const char* path, unsigned seed, int hordeSize);
+bool Replay_BeginPlayback(Replay* r, const char* path);   // sets r->seed and r->hordeSize
+
+// Once per simulation tick, before it runs. Recording appends *in; playback
+// overwrites *in and returns false once the log is exhausted.
+bool Replay_Tick(Replay* r, Input* in);
+
+// Closes the log. Recording writes the footer; playback reports whether the
+// session ended in the recorded state.
+void Replay_End(Replay* r, unsigned checksum);
+
+#endif
@@ -1,3 +1,14 @@
+// Keep the scalar path from fusing a * b + c into one FMA (-march=native
+// and clang's default both may): a fused result rounds once, not twice, and
+// would no longer match the SSE/AVX lanes bit for bit.
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
 #include "raylib.h"     
 #include "raymath.h"
 #include "game.h"
@@ -5,62 +16,247 @@
 #include "rival.h"
 #include "assets.h"
 #include "world.h"
+#include "flow.h"
+#include "profile.h"
+#include "text.h"
+#include <math.h>
+#include <string.h>
+
+// SIMD width is picked at compile time; define RIVALS_SCALAR to force the
+// plain C path (it is also used for the tail of every pass). All paths do
+// the same IEEE operations in the same order, so results match bit for bit
+// and replays stay valid across builds.
+#if !defined(RIVALS_SCALAR) && defined(__AVX__)
+#define RIVALS_AVX 1
+#include <immintrin.h>
+#elif !defined(RIVALS_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define RIVALS_SSE 1
+#include <emmintrin.h>
+#endif
+
+void Rivals_Init(RivalPool* pool) { *pool = (RivalPool){ 0 }; }
+
+void Rivals_Free(RivalPool* pool) {
+    MemFree(pool->x); MemFree(pool->y);
+    MemFree(pool->px); MemFree(pool->py);
+    MemFree(pool->hx); MemFree(pool->hy);
+    MemFree(pool->hitTimer); MemFree(pool->scale);
+    MemFree(pool->alive);
+    *pool = (RivalPool){ 0 };
+}
 
-Rival* Rival_Create(Vector2 spawn) {
-    Rival* r = MemAlloc(sizeof(Rival));
-    *r = (Rival){ .pos = spawn, .alive = true, .t = 0.0f };
-    r->scale = 1.8f;
-    return r;
+void Rivals_Spawn(RivalPool* pool, Vector2 pos, float scale) {
+    if (pool->count == pool->capacity) {
+        int cap = pool->capacity ? pool->capacity * 2 : 64;
+        pool->x = MemRealloc(pool->x, cap * sizeof(float));
+        pool->y = MemRealloc(pool->y, cap * sizeof(float));
+        pool->px = MemRealloc(pool->px, cap * sizeof(float));
+        pool->py = MemRealloc(pool->py, cap * sizeof(float));
+        pool->hx = MemRealloc(pool->hx, cap * sizeof(float));
+        pool->hy = MemRealloc(pool->hy, cap * sizeof(float));
+        pool->hitTimer = MemRealloc(pool->hitTimer, cap * sizeof(float));
+        pool->scale = MemRealloc(pool->scale, cap * sizeof(float));
+        pool->alive = MemRealloc(pool->alive, cap);
+        pool->capacity = cap;
+    }
+    int i = pool->count++;
+    pool->x[i] = pool->px[i] = pos.x;
+    pool->y[i] = pool->py[i] = pos.y;
+    pool->hitTimer[i] = 0.0f;
+    pool->scale[i] = scale;
+    pool->alive[i] = 1;
 }
-void Rival_Destroy(Rival* r) { MemFree(r); }
 
-void Rival_Update(Rival* r, Game* g, float dt) {
-    if (!r->alive || g->state != STATE_PLAYING) return;
-    r->t += dt;
+static int CountBits(unsigned m) { int n = 0; while (m) { m &= m - 1; n++; } return n; }
 
-    float speed = 120.0f + 80.0f * Game_IsNight(g);
-    Vector2 toP = Vector2Subtract(g->player->pos, r->pos);
-    float d = Vector2Length(toP);
-    if (d > 1) r->pos = Vector2Add(r->pos, Vector2Scale(Vector2Normalize(toP), speed * dt));
-
-    // hurt player on contact
-    if (d < 18.0f * r->scale) {
-        static float hitTimer = 0; hitTimer += dt;
-        if (hitTimer > 1.0f) {
-            g->player->hp--; if (g->player->hp < 0) g->player->hp = 0;
-            hitTimer = 0.0f;
-     
-            // NEW: screen effects
-            g->hitFlash = 0.6f;      // red flash strength
-            g->shakeTime = 0.25f;    // ~quarter second of shake
+// -----------------------------------------------------------------------------
+// Heading per rival: the shared flow field where it has one (routes around
+// ponds), otherwise straight at the target; zero once on top of it.
+static void Steer(RivalPool* p, const FlowField* flow, Vector2 target) {
+    for (int i = 0; i < p->count; i++) {
+        Vector2 dir;
+        if (Flow_Direction(flow, (Vector2) { p->x[i], p->y[i] }, &dir)) {
+            p->hx[i] = dir.x;
+            p->hy[i] = dir.y;
+            continue;
+        }
+        float dx = target.x - p->x[i], dy = target.y - p->y[i];
+        float d = sqrtf(dx * dx + dy * dy);
+        float inv = (d > 1.0f) ? 1.0f / d : 0.0f;
+        p->hx[i] = dx * inv;
+        p->hy[i] = dy * inv;
+    }
+}
+
+// Chase + contact for rivals [from, count): step along the heading, and while
+// touching the target (distance measured before the step) run the per-rival
+// hit timer. Returns the number of hits landed this tick.
+static int ChaseScalar(RivalPool* p, int from, Vector2 target, float step, float dt) {
+    int hits = 0;
+    for (int i = from; i < p->count; i++) {
+        float dx = target.x - p->x[i], dy = target.y - p->y[i];
+        float d = sqrtf(dx * dx + dy * dy);
+        p->px[i] = p->x[i];
+        p->py[i] = p->y[i];
+        p->x[i] += p->hx[i] * step;
+        p->y[i] += p->hy[i] * step;
+        if (d < RIVAL_CONTACT * p->scale[i]) {
+            p->hitTimer[i] += dt;
+            if (p->hitTimer[i] > 1.0f) { p->hitTimer[i] = 0.0f; hits++; }
         }
     }
+    return hits;
+}
+
+#if RIVALS_AVX
+static int Chase(RivalPool* p, Vector2 target, float step, float dt) {
+    const __m256 tx = _mm256_set1_ps(target.x), ty = _mm256_set1_ps(target.y);
+    const __m256 one = _mm256_set1_ps(1.0f), vstep = _mm256_set1_ps(step);
+    const __m256 vdt = _mm256_set1_ps(dt), contact = _mm256_set1_ps(RIVAL_CONTACT);
+    int hits = 0, i = 0;
+    for (; i + 8 <= p->count; i += 8) {
+        __m256 x = _mm256_loadu_ps(p->x + i), y = _mm256_loadu_ps(p->y + i);
+        _mm256_storeu_ps(p->px + i, x);
+        _mm256_storeu_ps(p->py + i, y);
+        __m256 dx = _mm256_sub_ps(tx, x), dy = _mm256_sub_ps(ty, y);
+        __m256 d = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+        x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_loadu_ps(p->hx + i), vstep));
+        y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_loadu_ps(p->hy + i), vstep));
+        _mm256_storeu_ps(p->x + i, x);
+        _mm256_storeu_ps(p->y + i, y);
+
+        __m256 touch = _mm256_cmp_ps(d, _mm256_mul_ps(contact, _mm256_loadu_ps(p->scale + i)), _CMP_LT_OQ);
+        __m256 t = _mm256_add_ps(_mm256_loadu_ps(p->hitTimer + i), _mm256_and_ps(touch, vdt));
+        __m256 hit = _mm256_and_ps(touch, _mm256_cmp_ps(t, one, _CMP_GT_OQ));
+        _mm256_storeu_ps(p->hitTimer + i, _mm256_andnot_ps(hit, t));
+        hits += CountBits((unsigned)_mm256_movemask_ps(hit));
+    }
+    return hits + ChaseScalar(p, i, target, step, dt);
+}
+#elif RIVALS_SSE
+static int Chase(RivalPool* p, Vector2 target, float step, float dt) {
+    const __m128 tx = _mm_set1_ps(target.x), ty = _mm_set1_ps(target.y);
+    const __m128 one = _mm_set1_ps(1.0f), vstep = _mm_set1_ps(step);
+    const __m128 vdt = _mm_set1_ps(dt), contact = _mm_set1_ps(RIVAL_CONTACT);
+    int hits = 0, i = 0;
+    for (; i + 4 <= p->count; i += 4) {
+        __m128 x = _mm_loadu_ps(p->x + i), y = _mm_loadu_ps(p->y + i);
+        _mm_storeu_ps(p->px + i, x);
+        _mm_storeu_ps(p->py + i, y);
+        __m128 dx = _mm_sub_ps(tx, x), dy = _mm_sub_ps(ty, y);
+        __m128 d = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        x = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(p->hx + i), vstep));
+        y = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(p->hy + i), vstep));
+        _mm_storeu_ps(p->x + i, x);
+        _mm_storeu_ps(p->y + i, y);
 
-    // player attack
-    if (g->player->hasSpear && g->player->attackCooldown <= 0 && IsKeyPressed(KEY_SPACE)) {
-        g->player->attackCooldown = 0.5f;
-        if (Vector2Distance(g->player->pos, r->pos) < 42.0f * r->scale)
-            r->alive = false;
+        __m128 touch = _mm_cmplt_ps(d, _mm_mul_ps(contact, _mm_loadu_ps(p->scale + i)));
+        __m128 t = _mm_add_ps(_mm_loadu_ps(p->hitTimer + i), _mm_and_ps(touch, vdt));
+        __m128 hit = _mm_and_ps(touch, _mm_cmpgt_ps(t, one));
+        _mm_storeu_ps(p->hitTimer + i, _mm_andnot_ps(hit, t));
+        hits += CountBits((unsigned)_mm_movemask_ps(hit));
     }
+    return hits + ChaseScalar(p, i, target, step, dt);
+}
+#else
+static int Chase(RivalPool* p, Vector2 target, float step, float dt) {
+    return ChaseScalar(p, 0, target, step, dt);
 }
+#endif
 
-void Rival_Draw(const Rival* r, const struct Assets* assets) {
-    if (!r->alive) return;
+// -----------------------------------------------------------------------------
+static int KillScalar(RivalPool* p, int from, Vector2 c) {
+    int killed = 0;
+    for (int i = from; i < p->count; i++) {
+        float dx = p->x[i] - c.x, dy = p->y[i] - c.y;
+        float r = RIVAL_REACH * p->scale[i];
+        if (dx * dx + dy * dy < r * r) { p->alive[i] = 0; killed++; }
+    }
+    return killed;
+}
 
+int Rivals_KillInRadius(RivalPool* p, Vector2 c) {
+    int killed = 0, i = 0;
+#if RIVALS_SSE || RIVALS_AVX
+    const __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), reach = _mm_set1_ps(RIVAL_REACH);
+    for (; i + 4 <= p->count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(p->x + i), cx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(p->y + i), cy);
+        __m128 r = _mm_mul_ps(reach, _mm_loadu_ps(p->scale + i));
+        unsigned m = (unsigned)_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(r, r)));
+        for (; m; m &= m - 1) {
+            int lane = 0;
+            while (!((m >> lane) & 1u)) lane++;
+            p->alive[i + lane] = 0;
+            killed++;
+        }
+    }
+#endif
+    return killed + KillScalar(p, i, c);
+}
+
+// swap-remove dead rivals so the next pass sees only live ones
+static void Compact(RivalPool* p) {
+    for (int i = 0; i < p->count;) {
+        if (p->alive[i]) { i++; continue; }
+        int last = --p->count;
+        p->x[i] = p->x[last];   p->y[i] = p->y[last];
+        p->px[i] = p->px[last]; p->py[i] = p->py[last];
+        p->hitTimer[i] = p->hitTimer[last];
+        p->scale[i] = p->scale[last];
+        p->alive[i] = p->alive[last];
+    }
+}
+
+void Rivals_Update(RivalPool* pool, Game* g, float dt) {
+    if (g->state != STATE_PLAYING) {
+        // standing still: nothing to interpolate
+        memcpy(pool->px, pool->x, pool->count * sizeof(float));
+        memcpy(pool->py, pool->y, pool->count * sizeof(float));
+        return;
+    }
+    PROF_ZONE(zone, "Rivals_Update");
+    Player* pl = g->player;
+
+    float speed = 120.0f + 80.0f * Game_IsNight(g);
+    Steer(pool, &g->flow, pl->pos);
+    int hits = Chase(pool, pl->pos, speed * dt, dt);
+
+    // hurt player on contact, once per rival whose timer ran out
+    if (hits > 0) {
+        pl->hp -= hits; if (pl->hp < 0) pl->hp = 0;
+        Game_Burst(g, FX_BLOOD, pl->pos, (Color) { 170, 20, 30, 255 }, 12 * hits);
+
+        // NEW: screen effects
+        g->hitFlash = 0.6f;      // red flash strength
+        g->shakeTime = 0.25f;    // ~quarter second of shake
+    }
+
+    // player attack: one area query over the whole pool
+    if (pool->count > 0 && pl->hasSpear && pl->attackCooldown <= 0 && Input_Pressed(&g->input, BTN_ATTACK)) {
+        pl->attackCooldown = 0.5f;
+        if (Rivals_KillInRadius(pool, pl->pos) > 0) {
+            for (int i = 0; i < pool->count; i++) {
+                if (!pool->alive[i]) Game_Burst(g, FX_BLOOD, Rivals_Pos(pool, i), (Color) { 120, 10, 20, 255 }, 20);
+            }
+            Compact(pool);
+        }
+    }
+    PROF_END(zone);
+}
+
+void Rival_Draw(Vector2 pos, float scale, const struct Assets* assets) {
     // shadow (scaled)
-    DrawEllipse((int)r->pos.x, (int)(r->pos.y + 6 * r->scale),
-        (int)(12 * r->scale), (int)(5 * r->scale),
+    DrawEllipse((int)pos.x, (int)(pos.y + 6 * scale),
+        (int)(12 * scale), (int)(5 * scale),
         Fade(BLACK, 0.25f));
 
     // main sprite (scaled)
-    Rectangle src = { 0, 0, (float)assets->texRival.width, (float)assets->texRival.height };
-    Rectangle dst = { r->pos.x, r->pos.y, 24.0f * r->scale, 24.0f * r->scale };
-    Vector2   origin = { 12.0f * r->scale, 12.0f * r->scale };
+    Rectangle dst = { pos.x, pos.y, 24.0f * scale, 24.0f * scale };
+    Vector2   origin = { 12.0f * scale, 12.0f * scale };
 
-    DrawTexturePro(assets->texRival, src, dst, origin, 0.0f, WHITE);
+    Assets_DrawSprite(assets->sprRival, dst, origin, 0.0f, WHITE);
 
     // label (optional)
-    DrawText("Rival", (int)(r->pos.x - 18 * r->scale), (int)(r->pos.y - 28 * r->scale), (int)(12 * r->scale), RAYWHITE);
+    Text_Draw("Rival", (int)(pos.x - 18 * scale), (int)(pos.y - 28 * scale), (int)(12 * scale), RAYWHITE);
 }
-
-
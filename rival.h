@@ -7,16 +7,41 @@
 struct Game;
 struct Assets;
 
-typedef struct Rival {
-    Vector2 pos;
-    bool alive;
-    float t;
-    float scale;         // NEW
-} Rival;
-
-Rival* Rival_Create(Vector2 spawn);
-void   Rival_Destroy(Rival* r);
-void   Rival_Update(Rival* r, struct Game* g, float dt);
-void   Rival_Draw(const Rival* r, const struct Assets* assets);
+#define RIVAL_SCALE     1.8f
+#define RIVAL_RADIUS    8.0f     // body radius for collisions, times scale
+#define RIVAL_CONTACT   18.0f    // contact radius, times scale
+#define RIVAL_REACH     42.0f    // spear reach against a rival, times scale
+
+// All rivals live in one structure-of-arrays pool so the per-tick chase and
+// contact pass streams through flat float arrays (SSE/AVX when available,
+// scalar otherwise). Dead rivals are swap-removed at the end of the tick,
+// so [0, count) is always the live set.
+typedef struct RivalPool {
+    float* x;  float* y;        // position
+    float* px; float* py;       // position before the last tick (render interpolation)
+    float* hx; float* hy;       // this tick's unit heading (scratch)
+    float* hitTimer;            // contact time toward the next hit on the player
+    float* scale;
+    unsigned char* alive;       // cleared by attacks, compacted after the tick
+    int    count;
+    int    capacity;
+} RivalPool;
+
+void Rivals_Init(RivalPool* pool);
+void Rivals_Free(RivalPool* pool);
+void Rivals_Spawn(RivalPool* pool, Vector2 pos, float scale);
+
+// One tick: chase the player, deal contact damage, resolve the spear attack.
+void Rivals_Update(RivalPool* pool, struct Game* g, float dt);
+
+// Area query: marks every rival within reach of `center` dead; returns how many.
+int  Rivals_KillInRadius(RivalPool* pool, Vector2 center);
+
+static inline Vector2 Rivals_Pos(const RivalPool* pool, int i) { return (Vector2){ pool->x[i], pool->y[i] }; }
+static inline Vector2 Rivals_DrawPos(const RivalPool* pool, int i, float alpha) {
+    return (Vector2){ pool->px[i] + (pool->x[i] - pool->px[i]) * alpha, pool->py[i] + (pool->y[i] - pool->py[i]) * alpha };
+}
+
+void Rival_Draw(Vector2 pos, float scale, const struct Assets* assets);
 
 #endif
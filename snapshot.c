@@ -0,0 +1,440 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L   // fsync and fileno under strict -std=c11
+#endif
+#include "snapshot.h"
+#include "game.h"
+#include "player.h"
+#include "world.h"
+#include "lz4.h"
+#include "mapfile.h"
+#include "timer.h"
+#include "profile.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <io.h>          // _commit
+#else
+#include <unistd.h>      // fsync
+#endif
+
+#define HEADER_BYTES 20
+
+struct SnapshotCapture {
+    Game       game;          // shallow copy: its pointers are never followed
+    Player     player;
+    int        rivalCount;
+    float*     rivals;        // x, y, hit timer, scale; rivalCount of each
+    unsigned   worldSeed, cluesTaken;
+    int        takenCount;
+    unsigned long long* taken;   // the world's taken-node keys, resident chunks or not
+    unsigned*  explored;      // minimap bits, game.map.words * game.map.h
+    double     seconds;       // main-thread time spent capturing
+};
+
+static void FreeCapture(SnapshotCapture* c) {
+    if (!c) return;
+    MemFree(c->rivals);
+    MemFree(c->taken);
+    MemFree(c->explored);
+    MemFree(c);
+}
+
+SnapshotCapture* Snapshot_Capture(const Game* g) {
+    PROF_ZONE(zone, "Snapshot_Capture");
+    double start = Timer_Now();
+    SnapshotCapture* c = MemAlloc(sizeof(SnapshotCapture));
+    c->game = *g;
+    c->player = *g->player;
+
+    const RivalPool* rp = &g->rivals;
+    c->rivalCount = rp->count;
+    if (rp->count > 0) {
+        c->rivals = MemAlloc(4 * rp->count * sizeof(float));
+        memcpy(c->rivals, rp->x, rp->count * sizeof(float));
+        memcpy(c->rivals + rp->count, rp->y, rp->count * sizeof(float));
+        memcpy(c->rivals + 2 * rp->count, rp->hitTimer, rp->count * sizeof(float));
+        memcpy(c->rivals + 3 * rp->count, rp->scale, rp->count * sizeof(float));
+    }
+
+    c->worldSeed = g->world->seed;
+    c->cluesTaken = g->world->cluesTaken;
+    c->takenCount = World_CopyTaken(g->world, NULL);
+    if (c->takenCount > 0) {
+        c->taken = MemAlloc(c->takenCount * sizeof(unsigned long long));
+        World_CopyTaken(g->world, c->taken);
+    }
+
+    const Minimap* m = &g->map;
+    c->explored = MemAlloc(m->words * m->h * sizeof(unsigned));
+    memcpy(c->explored, m->explored, m->words * m->h * sizeof(unsigned));
+
+    c->seconds = Timer_Now() - start;
+    PROF_END(zone);
+    return c;
+}
+
+// -----------------------------------------------------------------------------
+// Section stream. Fields are written one by one in little-endian order, so
+// the format doesn't depend on struct layout or the compiler.
+typedef struct Writer {
+    unsigned char* data;
+    int            size, cap;
+} Writer;
+
+static unsigned char* Reserve(Writer* w, int n) {
+    if (w->size + n > w->cap) {
+        while (w->size + n > w->cap) w->cap = w->cap ? w->cap * 2 : 4096;
+        w->data = MemRealloc(w->data, w->cap);
+    }
+    unsigned char* p = w->data + w->size;
+    w->size += n;
+    return p;
+}
+
+static void PutU32(Writer* w, unsigned v) {
+    unsigned char* b = Reserve(w, 4);
+    b[0] = (unsigned char)v; b[1] = (unsigned char)(v >> 8); b[2] = (unsigned char)(v >> 16); b[3] = (unsigned char)(v >> 24);
+}
+static void PutI32(Writer* w, int v) { PutU32(w, (unsigned)v); }
+static void PutF32(Writer* w, float f) { unsigned v; memcpy(&v, &f, 4); PutU32(w, v); }
+static void PutF64(Writer* w, double d) { unsigned long long v; memcpy(&v, &d, 8); PutU32(w, (unsigned)v); PutU32(w, (unsigned)(v >> 32)); }
+static void PutVec(Writer* w, Vector2 v) { PutF32(w, v.x); PutF32(w, v.y); }
+
+typedef struct Reader {
+    const unsigned char* data;
+    int                  size, at;
+    bool                 bad;      // ran past the end; every later read returns zeros
+} Reader;
+
+static const unsigned char* Take(Reader* r, int n) {
+    static const unsigned char kZeros[16];
+    if (r->bad || n > r->size - r->at) { r->bad = true; return kZeros; }
+    const unsigned char* p = r->data + r->at;
+    r->at += n;
+    return p;
+}
+
+static unsigned GetU32(Reader* r) {
+    const unsigned char* b = Take(r, 4);
+    return b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned)b[3] << 24);
+}
+static int     GetI32(Reader* r) { return (int)GetU32(r); }
+static float   GetF32(Reader* r) { unsigned v = GetU32(r); float f; memcpy(&f, &v, 4); return f; }
+static double  GetF64(Reader* r) { unsigned long long lo = GetU32(r), hi = GetU32(r), v = lo | (hi << 32); double d; memcpy(&d, &v, 8); return d; }
+static Vector2 GetVec(Reader* r) { Vector2 v; v.x = GetF32(r); v.y = GetF32(r); return v; }
+
+// a count that must fit in what is left of the stream at `each` bytes apiece
+static int GetCount(Reader* r, int each) {
+    int n = GetI32(r);
+    if (n < 0 || (long long)n * each > r->size - r->at) { r->bad = true; return 0; }
+    return n;
+}
+
+static unsigned Fnv1a(const unsigned char* p, int n) {
+    unsigned h = 2166136261u;
+    for (int i = 0; i < n; i++) h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+static void Encode(Writer* w, const SnapshotCapture* c) {
+    const Game* g = &c->game;
+    PutI32(w, g->state);
+    PutU32(w, g->rng);
+    PutF64(w, g->simTime);
+    PutF32(w, g->timeOfDay);
+    PutI32(w, g->forceNight);
+    PutF32(w, g->todTarget);
+    PutF32(w, g->todBlend);
+    PutF32(w, g->lightRadius);
+    PutF32(w, g->hitFlash);
+    PutF32(w, g->shakeTime);
+    PutVec(w, g->cam.offset);
+    PutVec(w, g->cam.target);
+    PutF32(w, g->cam.rotation);
+    PutF32(w, g->cam.zoom);
+    PutI32(w, g->input.screenW);   // the view the world streams around on load
+    PutI32(w, g->input.screenH);
+    PutI32(w, g->cluesCollected);
+    PutI32(w, g->totalCluesRequired);
+    PutF32(w, g->musicDayVol);
+    PutF32(w, g->musicNightVol);
+
+    const Player* p = &c->player;
+    PutI32(w, p->dir4);
+    PutVec(w, p->pos);
+    PutVec(w, p->vel);
+    PutF32(w, p->accel);
+    PutF32(w, p->friction);
+    PutF32(w, p->maxSpeed);
+    PutF32(w, p->speed);
+    PutI32(w, p->hp);
+    PutI32(w, p->hasSpear);
+    PutI32(w, p->invFood);
+    PutI32(w, p->invWater);
+    PutI32(w, p->invStick);
+    PutF32(w, p->hunger);
+    PutF32(w, p->thirst);
+    PutF32(w, p->attackCooldown);
+    PutF32(w, p->starveTimer);
+    PutF32(w, p->facing);
+    PutF32(w, p->scale);
+    PutF32(w, p->baseRadius);
+
+    PutI32(w, c->rivalCount);
+    for (int i = 0; i < 4 * c->rivalCount; i++) PutF32(w, c->rivals[i]);
+
+    PutU32(w, c->worldSeed);
+    PutU32(w, c->cluesTaken);
+    PutI32(w, c->takenCount);
+    for (int i = 0; i < c->takenCount; i++) {
+        PutU32(w, (unsigned)c->taken[i]);
+        PutU32(w, (unsigned)(c->taken[i] >> 32));
+    }
+
+    const Minimap* m = &g->map;
+    PutI32(w, m->w);
+    PutI32(w, m->h);
+    for (int i = 0; i < m->words * m->h; i++) PutU32(w, c->explored[i]);
+}
+
+// Fills a fresh capture; NULL if the stream is short or inconsistent.
+static SnapshotCapture* Decode(Reader* r) {
+    SnapshotCapture* c = MemAlloc(sizeof(SnapshotCapture));
+    Game* g = &c->game;
+    g->state = (GameState)GetI32(r);
+    g->rng = GetU32(r);
+    g->simTime = GetF64(r);
+    g->timeOfDay = GetF32(r);
+    g->forceNight = GetI32(r) != 0;
+    g->todTarget = GetF32(r);
+    g->todBlend = GetF32(r);
+    g->lightRadius = GetF32(r);
+    g->hitFlash = GetF32(r);
+    g->shakeTime = GetF32(r);
+    g->cam.offset = GetVec(r);
+    g->cam.target = GetVec(r);
+    g->cam.rotation = GetF32(r);
+    g->cam.zoom = GetF32(r);
+    g->input.screenW = GetI32(r);
+    g->input.screenH = GetI32(r);
+    g->cluesCollected = GetI32(r);
+    g->totalCluesRequired = GetI32(r);
+    g->musicDayVol = GetF32(r);
+    g->musicNightVol = GetF32(r);
+
+    Player* p = &c->player;
+    p->dir4 = GetI32(r);
+    p->pos = GetVec(r);
+    p->vel = GetVec(r);
+    p->accel = GetF32(r);
+    p->friction = GetF32(r);
+    p->maxSpeed = GetF32(r);
+    p->speed = GetF32(r);
+    p->hp = GetI32(r);
+    p->hasSpear = GetI32(r) != 0;
+    p->invFood = GetI32(r);
+    p->invWater = GetI32(r);
+    p->invStick = GetI32(r);
+    p->hunger = GetF32(r);
+    p->thirst = GetF32(r);
+    p->attackCooldown = GetF32(r);
+    p->starveTimer = GetF32(r);
+    p->facing = GetF32(r);
+    p->scale = GetF32(r);
+    p->baseRadius = GetF32(r);
+
+    c->rivalCount = GetCount(r, 16);
+    if (c->rivalCount > 0) {
+        c->rivals = MemAlloc(4 * c->rivalCount * sizeof(float));
+        for (int i = 0; i < 4 * c->rivalCount; i++) c->rivals[i] = GetF32(r);
+    }
+
+    c->worldSeed = GetU32(r);
+    c->cluesTaken = GetU32(r);
+    c->takenCount = GetCount(r, 8);
+    if (c->takenCount > 0) {
+        c->taken = MemAlloc(c->takenCount * sizeof(unsigned long long));
+        for (int i = 0; i < c->takenCount; i++) {
+            unsigned long long lo = GetU32(r), hi = GetU32(r);
+            c->taken[i] = lo | (hi << 32);
+        }
+    }
+
+    Minimap* m = &g->map;
+    m->w = GetI32(r);
+    m->h = GetI32(r);
+    m->words = (m->w + 31) / 32;
+    if (m->w <= 0 || m->h <= 0 || (long long)m->words * m->h * 4 != r->size - r->at) r->bad = true;
+    else {
+        c->explored = MemAlloc(m->words * m->h * sizeof(unsigned));
+        for (int i = 0; i < m->words * m->h; i++) c->explored[i] = GetU32(r);
+    }
+
+    if (r->bad) { FreeCapture(c); return NULL; }
+    return c;
+}
+
+// Compress and write to path + ".tmp", flush it to disk, then rename it over path.
+static bool WriteFile(const char* path, const unsigned char* raw, int rawSize, int* packedSize) {
+    unsigned char* packed = MemAlloc(HEADER_BYTES + LZ4_BOUND(rawSize));
+    int n = Lz4_Compress(packed + HEADER_BYTES, LZ4_BOUND(rawSize), raw, rawSize);
+    memcpy(packed, "SOSV", 4);
+    unsigned fields[4] = { SNAPSHOT_VERSION, (unsigned)rawSize, (unsigned)n, Fnv1a(raw, rawSize) };
+    for (int i = 0; i < 4; i++) {
+        for (int k = 0; k < 4; k++) packed[4 + 4 * i + k] = (unsigned char)(fields[i] >> (8 * k));
+    }
+
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* f = fopen(tmp, "wb");
+    bool ok = f != NULL;
+    if (ok) {
+        ok = fwrite(packed, 1, HEADER_BYTES + n, f) == (size_t)(HEADER_BYTES + n) && fflush(f) == 0;
+#if defined(_WIN32)
+        ok = ok && _commit(_fileno(f)) == 0;
+#else
+        ok = ok && fsync(fileno(f)) == 0;
+#endif
+        ok = fclose(f) == 0 && ok;
+    }
+#if defined(_WIN32)
+    if (ok) remove(path);   // rename won't replace an existing file here
+#endif
+    ok = ok && rename(tmp, path) == 0;
+    if (!ok) remove(tmp);
+    MemFree(packed);
+    *packedSize = n;
+    return ok;
+}
+
+bool Snapshot_WriteCapture(SnapshotCapture* c, const char* path) {
+    PROF_ZONE(zone, "Snapshot_Write");
+    double start = Timer_Now();
+    Writer w = { 0 };
+    Encode(&w, c);
+    int packed = 0;
+    bool ok = WriteFile(path, w.data, w.size, &packed);
+    if (ok) TraceLog(LOG_INFO, "SAVE: %s, %d -> %d bytes (captured in %.3f ms, written in %.1f ms)",
+        path, w.size, packed, c->seconds * 1e3, (Timer_Now() - start) * 1e3);
+    else TraceLog(LOG_WARNING, "SAVE: could not write %s", path);
+    MemFree(w.data);
+    FreeCapture(c);
+    PROF_END(zone);
+    return ok;
+}
+
+bool Snapshot_Save(const Game* g, const char* path) {
+    return Snapshot_WriteCapture(Snapshot_Capture(g), path);
+}
+
+// -----------------------------------------------------------------------------
+// Loading
+static void Apply(const SnapshotCapture* c, Game* g) {
+    const Game* s = &c->game;
+    g->state = s->state;
+    g->rng = s->rng;
+    g->simTime = s->simTime;
+    g->timeOfDay = s->timeOfDay;
+    g->forceNight = s->forceNight;
+    g->todTarget = s->todTarget;
+    g->todBlend = s->todBlend;
+    g->lightRadius = s->lightRadius;
+    g->hitFlash = s->hitFlash;
+    g->shakeTime = s->shakeTime;
+    g->cam = s->cam;
+    g->input.screenW = s->input.screenW;
+    g->input.screenH = s->input.screenH;
+    g->cluesCollected = s->cluesCollected;
+    g->totalCluesRequired = s->totalCluesRequired;
+    g->musicDayVol = s->musicDayVol;
+    g->musicNightVol = s->musicNightVol;
+    *g->player = c->player;
+
+    // the chunks come back from the seed, minus what was already taken
+    World_Destroy(g->world, &g->nodes);
+    g->world = World_Create(c->worldSeed, CHUNK_BUDGET, g->workers);
+    g->world->cluesTaken = c->cluesTaken;
+    World_RestoreTaken(g->world, c->taken, c->takenCount);
+    World_Stream(g->world, &g->nodes, Game_ViewRect(g));
+    g->nearNode = Nodes_FindInteractable(&g->nodes, g->player->pos);
+
+    RivalPool* rp = &g->rivals;
+    rp->count = 0;
+    for (int i = 0; i < c->rivalCount; i++) {
+        int n = c->rivalCount;
+        Rivals_Spawn(rp, (Vector2) { c->rivals[i], c->rivals[n + i] }, c->rivals[3 * n + i]);
+        rp->hitTimer[i] = c->rivals[2 * n + i];
+    }
+
+    Particles_Clear(&g->particles);
+    if (s->map.w == g->map.w && s->map.h == g->map.h) Minimap_Restore(&g->map, c->explored);
+
+    g->prevPose = (SimPose){ g->cam, g->player->pos };
+    g->pose = g->prevPose;
+    g->simAccum = 0.0;
+    g->simAlpha = 0.0f;
+    g->autosave.nextAt = g->simTime + AUTOSAVE_INTERVAL;
+}
+
+bool Snapshot_Load(Game* g, const char* path) {
+    PROF_ZONE(zone, "Snapshot_Load");
+    double start = Timer_Now();
+    MappedFile f;
+    if (!MappedFile_Open(&f, path)) { PROF_END(zone); return false; }
+
+    Reader h = { f.data, (int)f.size, 0, false };
+    bool magic = f.size >= HEADER_BYTES && memcmp(Take(&h, 4), "SOSV", 4) == 0;
+    unsigned version = GetU32(&h), rawSize = GetU32(&h), packedSize = GetU32(&h), hash = GetU32(&h);
+    SnapshotCapture* c = NULL;
+    if (magic && version == SNAPSHOT_VERSION && packedSize == f.size - HEADER_BYTES && rawSize < (1u << 30)) {
+        unsigned char* raw = MemAlloc(rawSize ? rawSize : 1);
+        int n = Lz4_Decompress(raw, (int)rawSize, f.data + HEADER_BYTES, (int)packedSize);
+        if (n == (int)rawSize && Fnv1a(raw, n) == hash) {
+            Reader r = { raw, n, 0, false };
+            c = Decode(&r);
+        }
+        MemFree(raw);
+    }
+    MappedFile_Close(&f);
+
+    if (!c) {
+        TraceLog(LOG_WARNING, "SAVE: %s is not a compatible save", path);
+        PROF_END(zone);
+        return false;
+    }
+    Apply(c, g);
+    FreeCapture(c);
+    TraceLog(LOG_INFO, "SAVE: resumed %s in %.1f ms", path, (Timer_Now() - start) * 1e3);
+    PROF_END(zone);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Autosave
+static void AutosaveJob(void* arg) {
+    Autosave* a = arg;
+    Snapshot_WriteCapture(a->pending, a->path);
+    a->pending = NULL;
+    Atomic_Store(&a->busy, 0);
+}
+
+void Autosave_Update(Autosave* a, const Game* g) {
+    if (!a->path || g->simTime < a->nextAt) return;
+    a->nextAt = g->simTime + AUTOSAVE_INTERVAL;
+    if (Atomic_Load(&a->busy)) return;   // the last one is still on its way to disk
+
+    a->pending = Snapshot_Capture(g);
+    Atomic_Store(&a->busy, 1);
+    WorkerPool_Submit(a->workers, AutosaveJob, a);
+}
+
+void Autosave_Wait(Autosave* a) {
+    while (Atomic_Load(&a->busy)) Thread_Sleep(1);
+}
+
+void Autosave_Discard(Autosave* a) {
+    if (!a->path) return;
+    Autosave_Wait(a);
+    remove(a->path);
+}
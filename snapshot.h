@@ -0,0 +1,49 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#include "thread.h"
+#include <stdbool.h>
+#pragma once
+
+// Save games. A snapshot holds the run's Game fields, the player, every
+// rival, the world seed with the clues and pickups already taken and the
+// explored-area map; chunks themselves are regenerated from the seed on load.
+// Particles are left out: a resumed run starts with none in flight.
+//
+// File layout (little-endian):
+//   header  "SOSV", u32 version, u32 raw bytes, u32 packed bytes, u32 FNV-1a of the raw bytes
+//   body    the raw section stream, LZ4 block compressed
+//
+// Saving is split so the main thread only copies: Snapshot_Capture takes a
+// shallow copy of the state (a few KB plus the rival arrays), and encoding,
+// compression, the write and the fsync all happen on a worker.
+// The file is written beside the target and renamed over it, so a crash
+// mid-save leaves the previous save intact. Loading maps the file and
+// decompresses straight from the mapping.
+#define SNAPSHOT_VERSION   4
+#define SNAPSHOT_PATH      "autosave.sos"
+#define AUTOSAVE_INTERVAL  30.0    // simulated seconds between autosaves
+
+struct Game;
+typedef struct SnapshotCapture SnapshotCapture;
+
+SnapshotCapture* Snapshot_Capture(const struct Game* g);
+bool             Snapshot_WriteCapture(SnapshotCapture* c, const char* path);   // frees c
+bool             Snapshot_Save(const struct Game* g, const char* path);         // both, on this thread
+
+// Restores into a Game that has been through Game_Init; the state comes back
+// as saved (STATE_PLAYING for autosaves). On failure g is left as it was.
+bool Snapshot_Load(struct Game* g, const char* path);
+
+typedef struct Autosave {
+    const char*  path;      // NULL: autosave off
+    WorkerPool*  workers;   // where saves are written; NULL writes them inline
+    double       nextAt;    // Game.simTime of the next autosave
+    volatile int busy;      // a save is in flight; the next one is skipped rather than queued
+    SnapshotCapture* pending;
+} Autosave;
+
+void Autosave_Update(Autosave* a, const struct Game* g);   // per tick while playing
+void Autosave_Wait(Autosave* a);                           // until the save in flight is on disk
+void Autosave_Discard(Autosave* a);                        // the run ended: wait, then delete the save
+
+#endif
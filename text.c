@@ -0,0 +1,111 @@
+#include "text.h"
+#include "arena.h"
+#include <string.h>
+
+#define TEXT_LINE_SPACING 2    // raylib's default for '\n'
+
+typedef struct TextEntry {
+    unsigned    hash;          // 0 = empty slot
+    int         fontSize;
+    const char* text;          // copy in the arena
+    TextLayout  layout;
+} TextEntry;
+
+static TextEntry slots[TEXT_CACHE_SLOTS];
+static int       entryCount;
+static unsigned  fontTexture;  // layouts are only valid for this font texture
+static Arena     arena;        // strings and glyph quads
+
+static unsigned Hash(const char* s, int fontSize) {
+    unsigned h = 2166136261u ^ (unsigned)fontSize;   // FNV-1a
+    for (; *s; s++) h = (h ^ (unsigned char)*s) * 16777619u;
+    return h ? h : 1;
+}
+
+static void Clear(void) {
+    memset(slots, 0, sizeof(slots));
+    entryCount = 0;
+    if (arena.blockSize) Arena_Reset(&arena);
+    else Arena_Init(&arena, 16 * 1024);
+}
+
+// The same walk DrawTextEx does, recording quads instead of drawing them
+static void Build(TextEntry* e, const char* text, int fontSize) {
+    Font font = GetFontDefault();
+    int   size = fontSize < 10 ? 10 : fontSize;   // DrawText's minimum and spacing
+    float spacing = (float)(size / 10);
+    float scale = (float)size / (float)font.baseSize;
+    float pad = (float)font.glyphPadding;
+
+    size_t len = strlen(text);
+    char* copy = Arena_Alloc(&arena, len + 1);
+    memcpy(copy, text, len + 1);
+    TextGlyph* glyphs = Arena_Alloc(&arena, (len ? len : 1) * sizeof(TextGlyph));   // at most one glyph per byte
+
+    int n = 0;
+    float ox = 0.0f, oy = 0.0f;
+    for (size_t i = 0; font.recs && i < len;) {   // no font before the window opens
+        int bytes = 0;
+        int cp = GetCodepointNext(text + i, &bytes);
+        int g = GetGlyphIndex(font, cp);
+        i += bytes ? bytes : 1;
+        if (cp == '\n') { ox = 0.0f; oy += (float)(size + TEXT_LINE_SPACING); continue; }
+        Rectangle r = font.recs[g];
+        if (cp != ' ' && cp != '\t') {
+            glyphs[n].src = (Rectangle){ r.x - pad, r.y - pad, r.width + 2.0f * pad, r.height + 2.0f * pad };
+            glyphs[n].dst = (Rectangle){ ox + (font.glyphs[g].offsetX - pad) * scale, oy + (font.glyphs[g].offsetY - pad) * scale,
+                (r.width + 2.0f * pad) * scale, (r.height + 2.0f * pad) * scale };
+            n++;
+        }
+        ox += (font.glyphs[g].advanceX ? (float)font.glyphs[g].advanceX : r.width) * scale + spacing;
+    }
+
+    e->fontSize = fontSize;
+    e->text = copy;
+    e->layout = (TextLayout){ font.texture, MeasureText(text, fontSize), n, glyphs };
+}
+
+const TextLayout* Text_Layout(const char* text, int fontSize) {
+    Font font = GetFontDefault();
+    if (font.texture.id != fontTexture) {
+        Clear();
+        fontTexture = font.texture.id;
+    }
+    unsigned h = Hash(text, fontSize);
+    unsigned i = h & (TEXT_CACHE_SLOTS - 1);
+    for (;; i = (i + 1) & (TEXT_CACHE_SLOTS - 1)) {
+        TextEntry* e = &slots[i];
+        if (!e->hash) break;
+        if (e->hash == h && e->fontSize == fontSize && strcmp(e->text, text) == 0) return &e->layout;
+    }
+    if (entryCount >= TEXT_CACHE_MAX) {   // full: start over rather than track use
+        Clear();
+        i = h & (TEXT_CACHE_SLOTS - 1);
+    }
+    TextEntry* e = &slots[i];
+    e->hash = h;
+    entryCount++;
+    Build(e, text, fontSize);
+    return &e->layout;
+}
+
+int Text_Width(const char* text, int fontSize) { return Text_Layout(text, fontSize)->width; }
+
+void Text_DrawLayout(const TextLayout* t, int x, int y, Color tint) {
+    for (int i = 0; i < t->glyphCount; i++) {
+        const TextGlyph* g = &t->glyphs[i];
+        Rectangle dst = { g->dst.x + (float)x, g->dst.y + (float)y, g->dst.width, g->dst.height };
+        DrawTexturePro(t->texture, g->src, dst, (Vector2) { 0, 0 }, 0.0f, tint);
+    }
+}
+
+void Text_Draw(const char* text, int x, int y, int fontSize, Color tint) {
+    Text_DrawLayout(Text_Layout(text, fontSize), x, y, tint);
+}
+
+void Text_Free(void) {
+    Arena_Free(&arena);
+    memset(slots, 0, sizeof(slots));
+    entryCount = 0;
+    fontTexture = 0;
+}
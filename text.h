@@ -0,0 +1,34 @@
+#ifndef TEXT_H
+#define TEXT_H
+#include "raylib.h"
+#pragma once
+
+// Cached text layout for raylib's default font. The first request for a
+// string at a size measures it and turns it into glyph quads; afterwards
+// drawing it is one textured quad per visible glyph, with no UTF-8 decoding,
+// glyph lookups or measuring. Output matches DrawText/MeasureText exactly.
+// Meant for strings that repeat frame to frame (labels, menus, HUD lines that
+// are re-formatted only when their values change): every distinct string
+// takes an entry, and the cache starts over when it fills.
+#define TEXT_CACHE_SLOTS 256   // hash table size, power of two
+#define TEXT_CACHE_MAX   192   // entries before the cache is cleared
+
+typedef struct TextGlyph {
+    Rectangle src;        // on the font texture
+    Rectangle dst;        // relative to the text's top-left corner
+} TextGlyph;
+
+typedef struct TextLayout {
+    Texture2D        texture;
+    int              width;    // == MeasureText
+    int              glyphCount;
+    const TextGlyph* glyphs;
+} TextLayout;
+
+const TextLayout* Text_Layout(const char* text, int fontSize);   // valid until a new string fills the cache
+int  Text_Width(const char* text, int fontSize);
+void Text_Draw(const char* text, int x, int y, int fontSize, Color tint);
+void Text_DrawLayout(const TextLayout* t, int x, int y, Color tint);
+void Text_Free(void);
+
+#endif
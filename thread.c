@@ -0,0 +1,195 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L   // pthreads, nanosleep, sysconf under strict -std=c11
+#endif
+#include "thread.h"
+#include <stdlib.h>
+
+// NOTE: no raylib.h here -- windows.h and raylib.h clash on several names.
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+typedef SRWLOCK            Mutex;
+typedef CONDITION_VARIABLE Cond;
+static void MutexInit(Mutex* m)           { InitializeSRWLock(m); }
+static void MutexDestroy(Mutex* m)        { (void)m; }
+static void MutexLock(Mutex* m)           { AcquireSRWLockExclusive(m); }
+static void MutexUnlock(Mutex* m)         { ReleaseSRWLockExclusive(m); }
+static void CondInit(Cond* c)             { InitializeConditionVariable(c); }
+static void CondDestroy(Cond* c)          { (void)c; }
+static void CondWait(Cond* c, Mutex* m)   { SleepConditionVariableSRW(c, m, INFINITE, 0); }
+static void CondBroadcast(Cond* c)        { WakeAllConditionVariable(c); }
+static void CondSignal(Cond* c)           { WakeConditionVariable(c); }
+
+typedef struct ThreadStart { ThreadFn fn; void* arg; } ThreadStart;
+
+static DWORD WINAPI ThreadMain(LPVOID p) {
+    ThreadStart s = *(ThreadStart*)p;
+    free(p);
+    s.fn(s.arg);
+    return 0;
+}
+
+bool Thread_Start(Thread* t, ThreadFn fn, void* arg) {
+    ThreadStart* s = malloc(sizeof(ThreadStart));
+    if (!s) return false;
+    s->fn = fn;
+    s->arg = arg;
+    t->handle = CreateThread(NULL, 0, ThreadMain, s, 0, NULL);
+    if (!t->handle) { free(s); return false; }
+    return true;
+}
+
+void Thread_Join(Thread* t) {
+    if (!t->handle) return;
+    WaitForSingleObject(t->handle, INFINITE);
+    CloseHandle(t->handle);
+    t->handle = NULL;
+}
+
+int Thread_CoreCount(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+
+void Thread_Sleep(int ms) { Sleep((DWORD)ms); }
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t  Cond;
+static void MutexInit(Mutex* m)           { pthread_mutex_init(m, NULL); }
+static void MutexDestroy(Mutex* m)        { pthread_mutex_destroy(m); }
+static void MutexLock(Mutex* m)           { pthread_mutex_lock(m); }
+static void MutexUnlock(Mutex* m)         { pthread_mutex_unlock(m); }
+static void CondInit(Cond* c)             { pthread_cond_init(c, NULL); }
+static void CondDestroy(Cond* c)          { pthread_cond_destroy(c); }
+static void CondWait(Cond* c, Mutex* m)   { pthread_cond_wait(c, m); }
+static void CondBroadcast(Cond* c)        { pthread_cond_broadcast(c); }
+static void CondSignal(Cond* c)           { pthread_cond_signal(c); }
+
+typedef struct ThreadStart { ThreadFn fn; void* arg; } ThreadStart;
+
+static void* ThreadMain(void* p) {
+    ThreadStart s = *(ThreadStart*)p;
+    free(p);
+    s.fn(s.arg);
+    return NULL;
+}
+
+bool Thread_Start(Thread* t, ThreadFn fn, void* arg) {
+    ThreadStart* s = malloc(sizeof(ThreadStart));
+    pthread_t* h = malloc(sizeof(pthread_t));
+    if (!s || !h) { free(s); free(h); return false; }
+    s->fn = fn;
+    s->arg = arg;
+    if (pthread_create(h, NULL, ThreadMain, s) != 0) { free(s); free(h); t->handle = NULL; return false; }
+    t->handle = h;
+    return true;
+}
+
+void Thread_Join(Thread* t) {
+    if (!t->handle) return;
+    pthread_join(*(pthread_t*)t->handle, NULL);
+    free(t->handle);
+    t->handle = NULL;
+}
+
+int Thread_CoreCount(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+void Thread_Sleep(int ms) {
+    struct timespec ts = { ms / 1000, (long)(ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// Worker pool: a ring of pending jobs guarded by one mutex. Jobs here are
+// coarse (decode a file, pack an atlas), so a single queue is plenty.
+#define POOL_MAX_THREADS 16
+
+typedef struct Job { ThreadFn fn; void* arg; } Job;
+
+struct WorkerPool {
+    Mutex  lock;
+    Cond   wake;
+    Job*   jobs;          // ring
+    int    head, count, capacity;
+    bool   quit;
+    int    threadCount;
+    Thread threads[POOL_MAX_THREADS];
+};
+
+static void WorkerMain(void* arg) {
+    WorkerPool* p = arg;
+    for (;;) {
+        MutexLock(&p->lock);
+        while (p->count == 0 && !p->quit) CondWait(&p->wake, &p->lock);
+        if (p->count == 0) { MutexUnlock(&p->lock); return; }   // quitting and drained
+        Job job = p->jobs[p->head];
+        p->head = (p->head + 1) % p->capacity;
+        p->count--;
+        MutexUnlock(&p->lock);
+
+        job.fn(job.arg);
+    }
+}
+
+WorkerPool* WorkerPool_Create(int threads) {
+    if (threads <= 0) threads = Thread_CoreCount() - 1;
+    if (threads < 1) threads = 1;
+    if (threads > POOL_MAX_THREADS) threads = POOL_MAX_THREADS;
+
+    WorkerPool* p = calloc(1, sizeof(WorkerPool));
+    if (!p) return NULL;
+    MutexInit(&p->lock);
+    CondInit(&p->wake);
+    p->capacity = 64;
+    p->jobs = malloc(p->capacity * sizeof(Job));
+    for (int i = 0; i < threads; i++) {
+        if (!Thread_Start(&p->threads[i], WorkerMain, p)) break;
+        p->threadCount++;
+    }
+    if (p->threadCount == 0) { WorkerPool_Destroy(p); return NULL; }
+    return p;
+}
+
+void WorkerPool_Submit(WorkerPool* p, ThreadFn fn, void* arg) {
+    if (!p) { fn(arg); return; }
+    MutexLock(&p->lock);
+    if (p->count == p->capacity) {
+        // unroll the ring into a bigger one
+        Job* jobs = malloc(2 * p->capacity * sizeof(Job));
+        for (int i = 0; i < p->count; i++) jobs[i] = p->jobs[(p->head + i) % p->capacity];
+        free(p->jobs);
+        p->jobs = jobs;
+        p->head = 0;
+        p->capacity *= 2;
+    }
+    p->jobs[(p->head + p->count) % p->capacity] = (Job){ fn, arg };
+    p->count++;
+    CondSignal(&p->wake);
+    MutexUnlock(&p->lock);
+}
+
+void WorkerPool_Destroy(WorkerPool* p) {
+    if (!p) return;
+    MutexLock(&p->lock);
+    p->quit = true;
+    CondBroadcast(&p->wake);
+    MutexUnlock(&p->lock);
+    for (int i = 0; i < p->threadCount; i++) Thread_Join(&p->threads[i]);
+
+    CondDestroy(&p->wake);
+    MutexDestroy(&p->lock);
+    free(p->jobs);
+    free(p);
+}
+
+int WorkerPool_Threads(const WorkerPool* p) { return p ? p->threadCount : 0; }
@@ -0,0 +1,41 @@
+#ifndef THREAD_H
+#define THREAD_H
+#include <stdbool.h>
+#pragma once
+
+// Minimal portable threading: raw threads, a fixed worker pool with a FIFO
+// job queue, and the few atomics the callers need to publish results.
+// Win32 threads/SRW locks on Windows, pthreads elsewhere.
+typedef void (*ThreadFn)(void* arg);
+
+typedef struct Thread {
+    void* handle;
+} Thread;
+
+bool Thread_Start(Thread* t, ThreadFn fn, void* arg);
+void Thread_Join(Thread* t);
+int  Thread_CoreCount(void);
+void Thread_Sleep(int ms);
+
+// Jobs run in submission order across the pool's threads. With pool == NULL,
+// WorkerPool_Submit runs the job inline, so callers need no second code path.
+typedef struct WorkerPool WorkerPool;
+
+WorkerPool* WorkerPool_Create(int threads);   // <= 0: one per core, minus the main thread
+void        WorkerPool_Submit(WorkerPool* p, ThreadFn fn, void* arg);
+void        WorkerPool_Destroy(WorkerPool* p);   // runs whatever is still queued, then joins
+int         WorkerPool_Threads(const WorkerPool* p);
+
+// Sequentially consistent int atomics, for flags and counters shared with workers
+#if defined(_MSC_VER)
+#include <intrin.h>
+static inline int  Atomic_Load(volatile int* p)         { return _InterlockedOr((volatile long*)p, 0); }
+static inline void Atomic_Store(volatile int* p, int v) { _InterlockedExchange((volatile long*)p, v); }
+static inline int  Atomic_Add(volatile int* p, int v)   { return _InterlockedExchangeAdd((volatile long*)p, v) + v; }
+#else
+static inline int  Atomic_Load(volatile int* p)         { return __atomic_load_n(p, __ATOMIC_SEQ_CST); }
+static inline void Atomic_Store(volatile int* p, int v) { __atomic_store_n(p, v, __ATOMIC_SEQ_CST); }
+static inline int  Atomic_Add(volatile int* p, int v)   { return __atomic_add_fetch(p, v, __ATOMIC_SEQ_CST); }
+#endif
+
+#endif
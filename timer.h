@@ -0,0 +1,9 @@
+#ifndef TIMER_H
+#define TIMER_H
+#pragma once
+
+// Monotonic high-resolution clock in seconds. Unlike GetTime() it works
+// without a window, so benchmarks and tooling can use it before InitWindow.
+double Timer_Now(void);
+
+#endif
@@ -3,7 +3,11 @@
 #include "raymath.h"   // DEG2RAD
 #include "game.h"
 #include "assets.h"
+#include "audio.h"
 #include "player.h"
+#include "profile.h"
+#include "text.h"
+#include "timer.h"
 #include <stdio.h>     // (optional) if you ever use snprintf
 #include "world.h"
 
@@ -17,30 +21,34 @@ static void DrawBar(int x, int y, int w, int h, float pct, Color fill) {
     DrawRectangleLines(x, y, w, h, (Color) { 0, 0, 0, 200 });
 }
 
+// A line of HUD text that is re-formatted only when the values it shows change
+typedef struct HudLine {
+    int  bound[4];
+    bool valid;
+    char text[96];
+} HudLine;
+
+static bool HudLine_Changed(HudLine* l, int a, int b, int c, int d) {
+    if (l->valid && l->bound[0] == a && l->bound[1] == b && l->bound[2] == c && l->bound[3] == d) return false;
+    l->bound[0] = a; l->bound[1] = b; l->bound[2] = c; l->bound[3] = d;
+    l->valid = true;
+    return true;
+}
+
+// HUD icon at its native size, drawn from the atlas
+static void DrawIcon(Sprite s, int x, int y) {
+    Rectangle dst = { (float)x, (float)y, s.src.width, s.src.height };
+    Assets_DrawSprite(s, dst, (Vector2) { 0, 0 }, 0.0f, WHITE);
+}
+
 // -----------------------------------------------------------------------------
 // Context prompt ("E to ...") shown when near a node
 static void UI_DrawContextPrompt(const Game* g) {
-    const float R_BERRY = 24.0f, R_STICK = 24.0f, R_CLUE = 36.0f, R_POND = 48.0f;
-
-    // Find first nearby node (simple)
-    const Node* best = NULL;
-    for (int i = 0; i < g->nodeCount; ++i) {
-        const Node* n = &g->nodes[i];
-        if ((n->type == NODE_BERRY || n->type == NODE_STICK || n->type == NODE_CLUE) && n->taken) continue;
-
-        float r = 0.0f;
-        switch (n->type) {
-        case NODE_BERRY: r = R_BERRY; break;
-        case NODE_STICK: r = R_STICK; break;
-        case NODE_CLUE:  r = R_CLUE;  break;
-        case NODE_POND:  r = R_POND;  break;
-        }
-        if (Vector2Distance(g->player->pos, n->pos) <= r) { best = n; break; }
-    }
-    if (!best) return;
+    // nearest interactable is resolved once per tick in Player_Update
+    if (g->nearNode == NODE_NONE) return;
 
     const char* what = "";
-    switch (best->type) {
+    switch (Nodes_Type(&g->nodes, g->nearNode)) {
     case NODE_BERRY: what = "E: Gather berries"; break;
     case NODE_STICK: what = "E: Pick up stick";  break;
     case NODE_POND:  what = "E: Drink water";    break;
@@ -49,38 +57,13 @@ static void UI_DrawContextPrompt(const Game* g) {
     }
 
     int fontSize = 18;
-    int w = MeasureText(what, fontSize);
+    int w = Text_Width(what, fontSize);
     int x = (GetScreenWidth() - w) / 2;
     int y = GetScreenHeight() - 40;
 
     DrawRectangle(x - 8, y - 6, w + 16, 28, (Color) { 0, 0, 0, 150 });
     DrawRectangleLines(x - 8, y - 6, w + 16, 28, (Color) { 0, 0, 0, 220 });
-    DrawText(what, x, y, fontSize, RAYWHITE);
-}
-
-// Draw floating pickup texts
-static void UI_DrawPopFX(const Game* g) {
-    for (int i = 0; i < g->popCount; ++i) {
-        const PopFX* p = &g->pops[i];
-        // convert world -> screen
-        Vector2 sp = GetWorldToScreen2D(p->pos, g->cam);
-
-        // motion + fade
-        float a = 1.0f - (p->t / 0.9f);           // 1 → 0
-        if (a < 0) a = 0;
-        int   yoff = (int)(p->t * 40.0f);         // float upward
-        int   fs = 16;
-        int   w = MeasureText(p->msg, fs);
-
-        Color shadow = (Color){ 0,0,0,(unsigned char)(180 * a) };
-        Color tint = p->color; tint.a = (unsigned char)(255 * a);
-
-        int sx = (int)(sp.x - w / 2);
-        int sy = (int)(sp.y - 18 - yoff);
-
-        DrawText(p->msg, sx + 1, sy + 1, fs, shadow);
-        DrawText(p->msg, sx, sy, fs, tint);
-    }
+    Text_Draw(what, x, y, fontSize, RAYWHITE);
 }
 
 // --- Smooth nightfall overlay ----------------------------------------------
@@ -108,78 +91,113 @@ void UI_DrawNightFade(const Game* g)
 }
 
 // -----------------------------------------------------------------------------
-// Main overlays: night + flashlight cone, hit flash, HUD, reticle, prompt
-void UI_DrawOverlays(const Game* g) {
-    // --- Night overlay + Flashlight CONE ---
-    float night = Game_IsNight(g);
-    if (night > 0.15f) {
-        float dark = 0.25f + 0.35f * night;
-        DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, dark));
-
-        if (g->lightRadius > 0.0f) {
-            Vector2 sp = GetWorldToScreen2D(g->player->pos, g->cam);
-            float  ang = g->player->facing;     // radians
-            float  fov = 42.0f * DEG2RAD;       // cone half-angle
-            float  R = g->lightRadius * g->player->scale;
-
-            Vector2 a = (Vector2){ sp.x + cosf(ang - fov) * R, sp.y + sinf(ang - fov) * R };
-            Vector2 b = (Vector2){ sp.x + cosf(ang + fov) * R, sp.y + sinf(ang + fov) * R };
-
-            BeginBlendMode(BLEND_ADDITIVE);
-            DrawTriangle(sp, a, b, (Color) { 255, 255, 255, 160 }); // cone
-            DrawCircleGradient((int)sp.x, (int)sp.y, (float)(R * 0.35f),
-                (Color) {
-                255, 255, 255, 220
-            }, (Color) { 0, 0, 0, 0 }); // soft origin
-            EndBlendMode();
-        }
+// Perf overlay: frame-time graph and percentiles, last frame's draw counters,
+// live counts. Everything shares the atlas page with the shapes, so the graph
+// is one batch; the panel reports its own cost, which must stay under 0.1 ms.
+static void UI_DrawPerfHud(const Game* g) {
+    static double lastCost;   // seconds spent here last frame
+    double start = Timer_Now();
+
+    const FrameStats* fs = &g->frames;
+    const int graphH = 60, lineH = 14, fontSize = 10;
+    int w = PERF_FRAMES + 12, h = graphH + 6 * lineH + 16;
+    int x0 = 10, y0 = GetScreenHeight() - h - 10;
+    DrawRectangle(x0, y0, w, h, (Color) { 0, 0, 0, 170 });
+
+    // graph: one column per frame, oldest on the left; the line is 60 fps
+    int gx = x0 + 6, gy = y0 + 6 + graphH;
+    float msPerPx = 33.3f / graphH;
+    for (int i = 0; i < fs->count; i++) {
+        float ms = fs->ms[(fs->next - fs->count + i + PERF_FRAMES) % PERF_FRAMES];
+        int   bh = (int)(ms / msPerPx);
+        if (bh > graphH) bh = graphH;
+        Color c = ms > 33.4f ? RED : ms > 17.5f ? ORANGE : LIME;
+        DrawRectangle(gx + i, gy - bh, 1, bh, c);
     }
+    DrawRectangle(gx, gy - (int)(16.7f / msPerPx), PERF_FRAMES, 1, Fade(RAYWHITE, 0.5f));
+
+    const SpriteStats* ss = &g_spriteStatsPrev;
+    const RenderStats* rs = &g->stats;
+    int ty = gy + 6;   // these numbers change every frame, so they skip the text cache
+    DrawText(TextFormat("frame p50 %.1f  p95 %.1f  p99 %.1f ms   (%d fps)",
+        FrameStats_Percentile(fs, 0.50f), FrameStats_Percentile(fs, 0.95f), FrameStats_Percentile(fs, 0.99f), GetFPS()),
+        gx, ty, fontSize, RAYWHITE); ty += lineH;
+    DrawText(TextFormat("draw  ~%d batches  %d binds  %d flushes  %d sprites  %d verts",
+        ss->pageSwitches + ss->flushes, ss->pageSwitches, ss->flushes, ss->sprites, ss->vertices),
+        gx, ty, fontSize, RAYWHITE); ty += lineH;
+    DrawText(TextFormat("cull  nodes %d / %d   actors %d / %d",
+        rs->nodesVisible, rs->nodesCulled, rs->actorsVisible, rs->actorsCulled),
+        gx, ty, fontSize, RAYWHITE); ty += lineH;
+    DrawText(TextFormat("chunks %d cached  %d live  %d baked   zoom %.2f",
+        rs->chunksCached, rs->chunksDirect, rs->chunksBaked, g->cam.zoom),
+        gx, ty, fontSize, RAYWHITE); ty += lineH;
+    DrawText(TextFormat("live  rivals %d  nodes %d  particles %d (%u evicted)  sfx %d KB", g->rivals.count, g->nodes.count,
+        g->particles.alive, g->particles.evicted, (int)(Audio_SfxResident() >> 10)),
+        gx, ty, fontSize, RAYWHITE); ty += lineH;
+    DrawText(TextFormat("overlay %.3f ms", lastCost * 1e3), gx, ty, fontSize, lastCost > 0.0001 ? RED : GRAY);
+
+    lastCost = Timer_Now() - start;
+}
 
-    // --- Hit flash overlay (kept under HUD so text stays readable) ---
-    if (g->hitFlash > 0.0f) {
-        DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(RED, g->hitFlash * 0.6f));
+// -----------------------------------------------------------------------------
+// Main overlays: HUD, reticle, prompt
+void UI_DrawOverlays(const Game* g) {
+    PROF_ZONE(zone, "UI_DrawOverlays");
+    if (g->state == STATE_INTRO) {   // the menu is the whole screen; sprites may not be in yet
+        if (g->showStats) UI_DrawPerfHud(g);
+        PROF_END(zone);
+        return;
     }
+    // night lighting and hit flash are composited by Game_Draw, under all of this
 
     // --- HUD bars & icons ---
     const int pad = 10;
     int x = pad, y = pad;
 
-    if (g->assets->uiHeart.id) DrawTexture(g->assets->uiHeart, x, y, WHITE);
+    DrawIcon(g->assets->uiHeart, x, y);
     DrawBar(x + 28, y + 4, 160, 14, g->player->hp / 3.0f, RED); y += 24;
 
-    if (g->assets->uiFood.id) DrawTexture(g->assets->uiFood, x, y, WHITE);
+    DrawIcon(g->assets->uiFood, x, y);
     DrawBar(x + 28, y + 4, 160, 14, g->player->hunger / 100.0f, (Color) { 200, 120, 50, 255 }); y += 24;
 
-    if (g->assets->uiWater.id) DrawTexture(g->assets->uiWater, x, y, WHITE);
+    DrawIcon(g->assets->uiWater, x, y);
     DrawBar(x + 28, y + 4, 160, 14, g->player->thirst / 100.0f, (Color) { 50, 140, 220, 255 }); y += 24;
 
-    DrawText(TextFormat("Food[1]: %d  Water[2]: %d  Sticks: %d  Spear: %s (F to craft)",
-        g->player->invFood, g->player->invWater, g->player->invStick,
-        g->player->hasSpear ? "Yes" : "No"),
-        pad, y + 2, 18, RAYWHITE);
+    static HudLine inventory, clues;
+    const Player* pl = g->player;
+    if (HudLine_Changed(&inventory, pl->invFood, pl->invWater, pl->invStick, pl->hasSpear))
+        snprintf(inventory.text, sizeof(inventory.text), "Food[1]: %d  Water[2]: %d  Sticks: %d  Spear: %s (F to craft)",
+            pl->invFood, pl->invWater, pl->invStick, pl->hasSpear ? "Yes" : "No");
+    Text_Draw(inventory.text, pad, y + 2, 18, RAYWHITE);
 
-    DrawText(TextFormat("Clues: %d / %d", g->cluesCollected, g->totalCluesRequired),
-        GetScreenWidth() - 130, 10, 22,
+    if (HudLine_Changed(&clues, g->cluesCollected, g->totalCluesRequired, 0, 0))
+        snprintf(clues.text, sizeof(clues.text), "Clues: %d / %d", g->cluesCollected, g->totalCluesRequired);
+    Text_Draw(clues.text, GetScreenWidth() - 130, 10, 22,
         (g->cluesCollected >= g->totalCluesRequired - 1 ? GOLD : YELLOW));
 
+    // explored-area map under the clue count
+    Minimap_Draw(&g->map, GetScreenWidth() - g->map.w * MAP_PX - pad, 40, g->pose.player);
+
     // small reticle
     Vector2 m = GetMousePosition();
     DrawLine((int)m.x - 6, (int)m.y, (int)m.x + 6, (int)m.y, Fade(RAYWHITE, 0.7f));
     DrawLine((int)m.x, (int)m.y - 6, (int)m.x, (int)m.y + 6, Fade(RAYWHITE, 0.7f));
 
+    // dev perf overlay (F3)
+    if (g->showStats) UI_DrawPerfHud(g);
+
     // context prompt (nearby interactable)
     UI_DrawContextPrompt(g);
-    // floating pickup texts
-    UI_DrawPopFX(g);
 
+    PROF_END(zone);
 }
 
 // -----------------------------------------------------------------------------
 // Pause & center messages
-void UI_DrawPause(void) {
+void UI_DrawPause(bool loading) {
     DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, 0.5f));
-    const char* p = "PAUSED (ESC to resume)";
-    DrawText(p, (GetScreenWidth() - MeasureText(p, 28)) / 2, GetScreenHeight() / 2 - 14, 28, RAYWHITE);
+    const char* p = loading ? "PAUSED (loading...)" : "PAUSED (ESC to resume)";
+    Text_Draw(p, (GetScreenWidth() - Text_Width(p, 28)) / 2, GetScreenHeight() / 2 - 14, 28, loading ? GRAY : RAYWHITE);
 }
 
 // ui.c 
@@ -192,15 +210,15 @@ void UI_DrawCenterMessage(const char* title, Color titleColor, const char* subti
     int titleSize = 40;
     int subSize = 20;
 
-    DrawText(title,
-        sw / 2 - MeasureText(title, titleSize) / 2,
+    Text_Draw(title,
+        sw / 2 - Text_Width(title, titleSize) / 2,
         sh / 2 - 60,
         titleSize, titleColor);
 
     if (subtitle && subtitle[0])
     {
-        DrawText(subtitle,
-            sw / 2 - MeasureText(subtitle, subSize) / 2,
+        Text_Draw(subtitle,
+            sw / 2 - Text_Width(subtitle, subSize) / 2,
             sh / 2 + 10,
             subSize, RAYWHITE);
     }
@@ -231,7 +249,7 @@ void UI_DrawIntro(const Game* g) {
     // title
     const char* title = "Survivor's Oath: Blood & Bonds";
     int ts = 42;
-    DrawText(title, sw / 2 - MeasureText(title, ts) / 2, sh / 5, ts, RAYWHITE);
+    Text_Draw(title, sw / 2 - Text_Width(title, ts) / 2, sh / 5, ts, RAYWHITE);
 
     // menu items
     const char* items[3] = { "New Game", "How To Play (H)", "Quit" };
@@ -239,7 +257,7 @@ void UI_DrawIntro(const Game* g) {
     int startY = sh / 2 - 10;
 
     for (int i = 0; i < 3; ++i) {
-        int w = MeasureText(items[i], fs);
+        int w = Text_Width(items[i], fs);
         int x = sw / 2 - w / 2;
         int y = startY + i * 40;
 
@@ -249,14 +267,25 @@ void UI_DrawIntro(const Game* g) {
             DrawRectangle(x - pad, y - 6, w + pad * 2, fs + 10, (Color) { 40, 60, 90, 140 });
             DrawRectangleLines(x - pad, y - 6, w + pad * 2, fs + 10, (Color) { 80, 120, 180, 220 });
         }
-        DrawText(items[i], x, y, fs, RAYWHITE);
+        bool waiting = (i == 0 && !Game_CanStart(g));   // New Game opens once the sprites are in
+        Text_Draw(items[i], x, y, fs, waiting ? GRAY : RAYWHITE);
+    }
+
+    // load progress while assets stream in on the workers
+    if (g->assets && g->assets->load) {
+        int bw = 260, bx = sw / 2 - bw / 2, by = sh - 60;
+        DrawBar(bx, by, bw, 10, g->assets->loadProgress, (Color) { 80, 120, 180, 255 });
+        static HudLine loading;
+        int pct = (int)(g->assets->loadProgress * 100.0f);
+        if (HudLine_Changed(&loading, pct, 0, 0, 0)) snprintf(loading.text, sizeof(loading.text), "Loading %d%%", pct);
+        Text_Draw(loading.text, sw / 2 - Text_Width(loading.text, 16) / 2, by - 22, 16, LIGHTGRAY);
     }
 
     // blinking "Press ENTER" hint
     if (((int)(g->introTimer * 2)) % 2 == 0) {
         const char* hint = "Press ENTER";
-        int hw = MeasureText(hint, 20);
-        DrawText(hint, sw / 2 - hw / 2, startY + 3 * 40 + 18, 20, LIGHTGRAY);
+        int hw = Text_Width(hint, 20);
+        Text_Draw(hint, sw / 2 - hw / 2, startY + 3 * 40 + 18, 20, LIGHTGRAY);
     }
 
     // help card overlay
@@ -267,15 +296,15 @@ void UI_DrawIntro(const Game* g) {
         DrawRectangleLines(x, y, w, h, (Color) { 100, 120, 160, 255 });
 
         int lh = 20, yy = y + 18, pad = 18;
-        DrawText("How To Play", x + pad, yy, 26, YELLOW); yy += 34;
-        DrawText("- WASD: Move", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
-        DrawText("- Mouse: Aim", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
-        DrawText("- E: Interact (gather, drink, clue)", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
-        DrawText("- 1/2: Eat / Drink from inventory", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
-        DrawText("- F: Craft spear (2 sticks)", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
-        DrawText("- SPACE: Attack (with spear)", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
-        DrawText("- Find 4 clues. After 3, night falls…", x + pad, yy, lh, RAYWHITE); yy += lh + 10;
-        DrawText("Press H to close", x + w - pad - MeasureText("Press H to close", lh), y + h - lh - 12, lh, LIGHTGRAY);
+        Text_Draw("How To Play", x + pad, yy, 26, YELLOW); yy += 34;
+        Text_Draw("- WASD: Move", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
+        Text_Draw("- Mouse: Aim", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
+        Text_Draw("- E: Interact (gather, drink, clue)", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
+        Text_Draw("- 1/2: Eat / Drink from inventory", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
+        Text_Draw("- F: Craft spear (2 sticks)", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
+        Text_Draw("- SPACE: Attack (with spear)", x + pad, yy, lh, RAYWHITE); yy += lh + 6;
+        Text_Draw("- Find 4 clues. After 3, night falls…", x + pad, yy, lh, RAYWHITE); yy += lh + 10;
+        Text_Draw("Press H to close", x + w - pad - Text_Width("Press H to close", lh), y + h - lh - 12, lh, LIGHTGRAY);
     }
 }
 
@@ -300,15 +329,15 @@ void UI_DrawStory(const Game* g)
 
     // title
     const char* title = "Survivor's Oath: Blood & Bonds";
-    DrawText(title, sw / 2 - MeasureText(title, titleSize) / 2, sh / 5, titleSize, RAYWHITE);
+    Text_Draw(title, sw / 2 - Text_Width(title, titleSize) / 2, sh / 5, titleSize, RAYWHITE);
 
     // current line
     int idx = g->storyIndex;
     if (idx < 0) idx = 0;
     const char* line = LINES[(idx < STORY_LINE_COUNT) ? idx : (STORY_LINE_COUNT - 1)];
 
-    DrawText(line,
-        sw / 2 - MeasureText(line, bodySize) / 2,
+    Text_Draw(line,
+        sw / 2 - Text_Width(line, bodySize) / 2,
         sh / 2 - 20,
         bodySize, LIGHTGRAY);
 
@@ -317,8 +346,8 @@ void UI_DrawStory(const Game* g)
         const char* hint = (g->storyIndex < STORY_LINE_COUNT - 1) ?
             "Press ENTER to continue" :
             "Press ENTER to begin";
-        DrawText(hint,
-            sw / 2 - MeasureText(hint, 18) / 2,
+        Text_Draw(hint,
+            sw / 2 - Text_Width(hint, 18) / 2,
             sh - 80,
             18, (Color) { 200, 200, 200, 220 });
     }
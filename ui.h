@@ -7,7 +7,7 @@
 
 void UI_DrawIntro(const Game* g);
 void UI_DrawOverlays(const Game* g);
-void UI_DrawPause(void);
+void UI_DrawPause(bool loading);   // loading: ESC is held back until the sprites are in
 void UI_DrawWin(const Game* g);
 void UI_DrawDeath(const Game* g);
 void UI_DrawNightFade(const Game* g);   // if you added the cinematic fade
@@ -15,4 +15,4 @@ void UI_DrawCenterMessage(const char* title, Color titleColor, const char* subti
 void UI_DrawStory(const Game* g);
 
 #pragma once
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -1,80 +1,456 @@
 #include "world.h"
 #include "raylib.h"
 #include "raymath.h"
+#include "profile.h"
 #include <stdlib.h>
-#define NODE_SCALE 1.8f   // Match your player/rival scale
+#include <math.h>
 
-static float frand(float a, float b) { return a + ((float)rand() / (float)RAND_MAX) * (b - a); }
+static int ChunkCoord(float v) { return (int)floorf(v / CHUNK_SIZE); }
 
-void World_SpawnScatter(Node* out, int* count, int cap, int type, int num) {
-    for (int i = 0; i < num && *count < cap; i++) {
-        out[(*count)++] = (Node){ .pos = (Vector2){ frand(100.0f, WORLD_W - 100.0f), frand(100.0f, WORLD_H - 100.0f) },
-                                  .type = type, .taken = false };
+// Grass tint from the biome: dry meadow, lusher where wet, darker under trees
+static Color GroundTint(float moisture, float forest) {
+    float wet = Clamp((moisture - 0.4f) * 3.0f, 0.0f, 1.0f), wood = Clamp((forest - 0.4f) * 3.0f, 0.0f, 0.8f);
+    float r = Lerp(Lerp(255.0f, 210.0f, wet), 175.0f, wood);
+    float g = Lerp(Lerp(248.0f, 235.0f, wet), 205.0f, wood);
+    float b = Lerp(Lerp(220.0f, 225.0f, wet), 170.0f, wood);
+    return (Color){ (unsigned char)r, (unsigned char)g, (unsigned char)b, 255 };
+}
+
+// -----------------------------------------------------------------------------
+// Taken nodes. A key packs the chunk, the type and the node's index in its
+// chunk's plan (its tag); the top bit keeps it non-zero.
+static unsigned long long TakenKey(int cx, int cy, NodeType type, int index) {
+    return (1ull << 63) | ((unsigned long long)(cx & 0xFFFFFF) << 36) | ((unsigned long long)(cy & 0xFFFFFF) << 12)
+        | ((unsigned long long)(type & 0xF) << 8) | (unsigned long long)(index & 0xFF);
+}
+
+static int TakenSlot(unsigned long long key, int cap) {
+    unsigned long long h = key * 0x9E3779B97F4A7C15ull;
+    return (int)(h >> 40) & (cap - 1);
+}
+
+static bool TakenHas(const World* w, unsigned long long key) {
+    if (w->takenCount == 0) return false;
+    for (int i = TakenSlot(key, w->takenCap);; i = (i + 1) & (w->takenCap - 1)) {
+        if (w->taken[i] == key) return true;
+        if (w->taken[i] == 0) return false;
     }
 }
 
-#include "world.h"
-#include "assets.h"
+static void TakenAdd(World* w, unsigned long long key) {
+    if (2 * (w->takenCount + 1) > w->takenCap) {
+        // grow and rehash at half full
+        int cap = w->takenCap ? 2 * w->takenCap : 256;
+        unsigned long long* old = w->taken;
+        int oldCap = w->takenCap;
+        w->taken = MemAlloc(cap * sizeof(unsigned long long));
+        w->takenCap = cap;
+        w->takenCount = 0;
+        for (int i = 0; i < oldCap; i++) {
+            if (old[i]) TakenAdd(w, old[i]);
+        }
+        MemFree(old);
+    }
+    int i = TakenSlot(key, w->takenCap);
+    while (w->taken[i] && w->taken[i] != key) i = (i + 1) & (w->takenCap - 1);
+    if (w->taken[i] == 0) { w->taken[i] = key; w->takenCount++; }
+}
+
+// Move a finished plan into the node store (main thread only)
+static void LoadChunk(World* w, NodeStore* nodes, Chunk* c, const ChunkPlan* plan) {
+    for (int t = 0; t < NODE_TYPE_COUNT; t++) c->page[t] = -1;
+    c->bake = -1;
+    c->dirty = true;
 
-void World_DrawGround(struct Assets* assets) {
-    (void)assets; // not used
-    // Flat ground across the whole world  simple, safe, unbreakable
-    DrawRectangle(0, 0, WORLD_W, WORLD_H, (Color) { 34, 46, 40, 255 });
+    for (int t = 0; t < NODE_TYPE_COUNT; t++) {
+        for (int i = 0; i < plan->count[t]; i++) {
+            if (TakenHas(w, TakenKey(c->cx, c->cy, t, i))) continue;
+            if (c->page[t] < 0) c->page[t] = Nodes_NewPage(nodes, t);
+            Nodes_AddTo(nodes, c->page[t], plan->pos[t][i], i);
+        }
+    }
+
+    for (int i = 0; i < MAX_CLUES; i++) {
+        if (w->cluesTaken & (1u << i)) continue;
+        if (ChunkCoord(w->clues[i].x) != c->cx || ChunkCoord(w->clues[i].y) != c->cy) continue;
+        if (c->page[NODE_CLUE] < 0) c->page[NODE_CLUE] = Nodes_NewPage(nodes, NODE_CLUE);
+        Nodes_AddTo(nodes, c->page[NODE_CLUE], w->clues[i], i);
+    }
+
+    // one biome sample per tile, from its top-left corner
+    const int stride = GEN_GRID / CHUNK_TILES;
+    for (int ty = 0; ty < CHUNK_TILES; ty++) {
+        for (int tx = 0; tx < CHUNK_TILES; tx++) {
+            int s = ty * stride * GEN_GRID + tx * stride;
+            c->ground[ty * CHUNK_TILES + tx] = GroundTint(plan->moisture[s], plan->forest[s]);
+        }
+    }
 }
 
-// define the static pointer
-Assets* g_worldAssets = NULL;
+static Chunk* FindChunk(const World* w, int cx, int cy) {
+    for (int i = 0; i < w->chunkCount; i++) {
+        if (w->chunks[i].cx == cx && w->chunks[i].cy == cy) return (Chunk*)&w->chunks[i];
+    }
+    return NULL;
+}
 
-void World_DrawNodes(Node* nodes, int nodeCount, struct Assets* assets) {
-    const float S = 1.8f;  // global visual scale for world items (match player/rival)
+static void DropChunk(World* w, NodeStore* nodes, Chunk* c) {
+    for (int t = 0; t < NODE_TYPE_COUNT; t++) {
+        if (c->page[t] >= 0) Nodes_FreePage(nodes, c->page[t]);
+        c->page[t] = -1;
+    }
+    if (c->bake >= 0) w->bakeOwner[c->bake] = -1;
+    c->bake = -1;
+}
 
-    for (int i = 0; i < nodeCount; i++) {
-        Node* n = &nodes[i];
+// Sprites overhang chunk edges, so a chunk's cached texture also shows its
+// neighbours' nodes: anything that changes near an edge dirties both sides.
+static void MarkDirty(World* w, Rectangle r) {
+    int x0 = ChunkCoord(r.x), x1 = ChunkCoord(r.x + r.width);
+    int y0 = ChunkCoord(r.y), y1 = ChunkCoord(r.y + r.height);
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            Chunk* c = FindChunk(w, cx, cy);
+            if (c) c->dirty = true;
+        }
+    }
+}
+
+World* World_Create(unsigned seed, int budget, WorkerPool* workers) {
+    World* w = MemAlloc(sizeof(World));
+    w->seed = seed;
+    w->workers = workers;
+    for (int i = 0; i < BAKE_POOL; i++) w->bakeOwner[i] = -1;
+    w->budget = (budget > 0) ? budget : CHUNK_BUDGET;
+    w->chunks = MemAlloc(w->budget * sizeof(Chunk));
+    w->plans = MemAlloc(w->budget * sizeof(ChunkPlan));
+
+    // clue spots depend only on the seed; nothing else grows on them or on the spawn
+    Gen_PlaceClues(seed, w->clues, MAX_CLUES, HOME_W, HOME_H);
+    w->gen.seed = seed;
+    for (int i = 0; i < MAX_CLUES; i++) w->gen.keepOut[w->gen.keepOutCount++] = w->clues[i];
+    w->gen.keepOut[w->gen.keepOutCount++] = (Vector2){ HOME_W / 2.0f, HOME_H / 2.0f };
+    return w;
+}
 
-        switch (n->type) {
-        case NODE_BERRY:
-            if (!n->taken) {
-                Rectangle src = (Rectangle){ 0.0f, 0.0f,
-                    (float)assets->texBerry.width, (float)assets->texBerry.height };
-                Rectangle dst = (Rectangle){ n->pos.x, n->pos.y, 16.0f * S, 16.0f * S };
-                Vector2   origin = (Vector2){ 8.0f * S, 8.0f * S };
-                DrawTexturePro(assets->texBerry, src, dst, origin, 0.0f, WHITE);
+void World_Destroy(World* w, NodeStore* nodes) {
+    if (!w) return;
+    for (int i = 0; i < w->chunkCount; i++) DropChunk(w, nodes, &w->chunks[i]);
+    for (int i = 0; i < BAKE_PAGES; i++) {
+        if (w->bakePage[i].id) UnloadRenderTexture(w->bakePage[i]);
+    }
+    MemFree(w->plans);
+    MemFree(w->taken);
+    MemFree(w->chunks);
+    MemFree(w);
+}
+
+void World_Stream(World* w, NodeStore* nodes, Rectangle view) {
+    w->tick++;
+
+    int x0 = ChunkCoord(view.x) - CHUNK_MARGIN, x1 = ChunkCoord(view.x + view.width) + CHUNK_MARGIN;
+    int y0 = ChunkCoord(view.y) - CHUNK_MARGIN, y1 = ChunkCoord(view.y + view.height) + CHUNK_MARGIN;
+    int ccx = ChunkCoord(view.x + view.width * 0.5f), ccy = ChunkCoord(view.y + view.height * 0.5f);
+
+    // mark what is already resident
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            Chunk* c = FindChunk(w, cx, cy);
+            if (c) c->lastSeen = w->tick;
+        }
+    }
+
+    // slots this call may fill: free ones, plus every chunk the view no longer wants
+    int room = w->budget - w->chunkCount;
+    for (int i = 0; i < w->chunkCount; i++) room += (w->chunks[i].lastSeen != w->tick);
+
+    // missing chunks in rings around the center, so the budget is spent nearest-first
+    int maxRing = 0;
+    if (ccx - x0 > maxRing) maxRing = ccx - x0;
+    if (x1 - ccx > maxRing) maxRing = x1 - ccx;
+    if (ccy - y0 > maxRing) maxRing = ccy - y0;
+    if (y1 - ccy > maxRing) maxRing = y1 - ccy;
+
+    int want = 0;
+    for (int ring = 0; ring <= maxRing && want < room; ring++) {
+        for (int cy = ccy - ring; cy <= ccy + ring && want < room; cy++) {
+            for (int cx = ccx - ring; cx <= ccx + ring && want < room; cx++) {
+                if (abs(cx - ccx) != ring && abs(cy - ccy) != ring) continue;   // ring edge only
+                if (cx < x0 || cx > x1 || cy < y0 || cy > y1) continue;
+                if (FindChunk(w, cx, cy)) continue;
+                w->plans[want].cx = cx;
+                w->plans[want].cy = cy;
+                want++;
             }
-            break;
-
-        case NODE_STICK:
-            if (!n->taken) {
-                Rectangle src = (Rectangle){ 0.0f, 0.0f,
-                    (float)assets->texStick.width, (float)assets->texStick.height };
-                Rectangle dst = (Rectangle){ n->pos.x, n->pos.y, 12.0f * S, 18.0f * S };
-                Vector2   origin = (Vector2){ 6.0f * S, 9.0f * S };
-                DrawTexturePro(assets->texStick, src, dst, origin, 0.0f, WHITE);
+        }
+    }
+    if (want == 0) return;
+
+    // plan them all at once on the workers, then move them in nearest-first
+    Gen_PlanChunks(&w->gen, w->plans, want, w->workers);
+    for (int k = 0; k < want; k++) {
+        Chunk* slot = NULL;
+        if (w->chunkCount < w->budget) {
+            slot = &w->chunks[w->chunkCount++];
+        }
+        else {
+            // evict the least recently wanted chunk outside the ring
+            for (int i = 0; i < w->chunkCount; i++) {
+                Chunk* c = &w->chunks[i];
+                if (c->lastSeen == w->tick) continue;
+                if (!slot || c->lastSeen < slot->lastSeen) slot = c;
             }
-            break;
-
-        case NODE_POND: {
-            Rectangle src = (Rectangle){ 0.0f, 0.0f,
-                (float)assets->texPond.width, (float)assets->texPond.height };
-            Rectangle dst = (Rectangle){ n->pos.x, n->pos.y, 64.0f * S, 64.0f * S };
-            Vector2   origin = (Vector2){ 32.0f * S, 32.0f * S };
-            DrawTexturePro(assets->texPond, src, dst, origin, 0.0f, WHITE);
-        } break;
-
-        case NODE_CLUE:
-            if (!n->taken) {
-                float pulse = (sinf((float)GetTime() * 4.0f) * 0.5f + 0.5f);
-                Color tint = (Color){ 255, 255, 255, (unsigned char)(190 + 55 * pulse) };
-
-                Rectangle src = (Rectangle){ 0.0f, 0.0f,
-                    (float)assets->texClue.width, (float)assets->texClue.height };
-                Rectangle dst = (Rectangle){ n->pos.x, n->pos.y, 18.0f * S, 18.0f * S };
-                Vector2   origin = (Vector2){ 9.0f * S, 9.0f * S };
-                DrawTexturePro(assets->texClue, src, dst, origin, 0.0f, tint);
+            if (!slot) return;   // budget exhausted by the view itself
+            DropChunk(w, nodes, slot);
+        }
+
+        int cx = w->plans[k].cx, cy = w->plans[k].cy;
+        slot->cx = cx;
+        slot->cy = cy;
+        slot->lastSeen = w->tick;
+        LoadChunk(w, nodes, slot, &w->plans[k]);
+        MarkDirty(w, (Rectangle) { (cx - 1) * CHUNK_SIZE, (cy - 1) * CHUNK_SIZE, 2.5f * CHUNK_SIZE, 2.5f * CHUNK_SIZE });
+    }
+}
+
+bool World_IsLoaded(const World* w, Vector2 pos) {
+    return FindChunk(w, ChunkCoord(pos.x), ChunkCoord(pos.y)) != NULL;
+}
+
+// Per-type sprite size in unscaled world units (origin is the sprite center).
+typedef struct NodeSprite {
+    float w, h;
+} NodeSprite;
+
+static const NodeSprite kNodeSprite[NODE_TYPE_COUNT] = {
+    [NODE_BERRY] = { 16.0f, 16.0f },
+    [NODE_STICK] = { 12.0f, 18.0f },
+    [NODE_POND]  = { 64.0f, 64.0f },
+    [NODE_CLUE]  = { 18.0f, 18.0f },
+};
+
+void World_OnTaken(World* w, const NodeStore* nodes, NodeId id) {
+    NodeType type = Nodes_Type(nodes, id);
+    Vector2 p = Nodes_Pos(nodes, id);
+    if (type == NODE_CLUE) {
+        w->cluesTaken |= 1u << Nodes_Tag(nodes, id);
+    }
+    else {
+        // keyed by the chunk that owns the page, not by position, which may round onto an edge
+        for (int i = 0; i < w->chunkCount; i++) {
+            const Chunk* c = &w->chunks[i];
+            if (c->page[type] == (id >> NODE_PAGE_SHIFT)) TakenAdd(w, TakenKey(c->cx, c->cy, type, Nodes_Tag(nodes, id)));
+        }
+    }
+
+    // the pickup vanishes from every cached chunk its sprite overlaps
+    float hw = kNodeSprite[type].w * NODE_SCALE * 0.5f, hh = kNodeSprite[type].h * NODE_SCALE * 0.5f;
+    MarkDirty(w, (Rectangle) { p.x - hw, p.y - hh, 2.0f * hw, 2.0f * hh });
+}
+
+int World_CopyTaken(const World* w, unsigned long long* out) {
+    if (out) {
+        int n = 0;
+        for (int i = 0; i < w->takenCap; i++) {
+            if (w->taken[i]) out[n++] = w->taken[i];
+        }
+    }
+    return w->takenCount;
+}
+
+void World_RestoreTaken(World* w, const unsigned long long* keys, int count) {
+    for (int i = 0; i < count; i++) {
+        if (keys[i]) TakenAdd(w, keys[i]);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Drawing
+#include "world.h"
+#include "assets.h"
+
+// define the static pointer
+Assets* g_worldAssets = NULL;
+
+#define GRASS_TILE (CHUNK_SIZE / CHUNK_TILES)   // world units per ground tile
+
+// ponds underneath, then resting pickups; clues pulse so they are never cached
+static const NodeType kStaticTypes[] = { NODE_POND, NODE_BERRY, NODE_STICK };
+#define STATIC_TYPE_COUNT (int)(sizeof(kStaticTypes) / sizeof(kStaticTypes[0]))
+
+static Sprite NodeImage(const struct Assets* assets, NodeType type) {
+    switch (type) {
+    case NODE_BERRY: return assets->sprBerry;
+    case NODE_STICK: return assets->sprStick;
+    case NODE_POND:  return assets->sprPond;
+    default:         return assets->sprClue;
+    }
+}
+
+static Rectangle ChunkRect(const Chunk* c) {
+    return (Rectangle){ c->cx * CHUNK_SIZE, c->cy * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE };
+}
+
+static void DrawGroundTiles(const struct Assets* assets, const Chunk* c) {
+    Rectangle r = ChunkRect(c);
+    for (int ty = 0; ty < CHUNK_TILES; ty++) {
+        for (int tx = 0; tx < CHUNK_TILES; tx++) {
+            Rectangle dst = { r.x + tx * GRASS_TILE, r.y + ty * GRASS_TILE, GRASS_TILE, GRASS_TILE };
+            Assets_DrawSprite(assets->sprGrass, dst, (Vector2) { 0, 0 }, 0.0f, c->ground[ty * CHUNK_TILES + tx]);
+        }
+    }
+}
+
+// Draw one page's untaken nodes that overlap clip (sprite, size and tint resolved by the caller).
+static void DrawPageNodes(const NodePage* page, Sprite spr, NodeType type, Color tint, Rectangle clip, RenderStats* stats) {
+    const float S = NODE_SCALE;  // global visual scale for world items (match player/rival)
+    float   w = kNodeSprite[type].w * S, h = kNodeSprite[type].h * S;
+    Vector2 origin = (Vector2){ w * 0.5f, h * 0.5f };
+
+    // a node is visible if its sprite overlaps clip: grow clip by half a sprite
+    float vx0 = clip.x - origin.x, vx1 = clip.x + clip.width + origin.x;
+    float vy0 = clip.y - origin.y, vy1 = clip.y + clip.height + origin.y;
+
+    // whole page outside (the common case far from the camera)
+    const Rectangle* b = &page->bounds;
+    if (b->x > vx1 || b->x + b->width < vx0 || b->y > vy1 || b->y + b->height < vy0) {
+        for (int i = 0; i < page->count; i++) stats->nodesCulled += !page->taken[i];
+        return;
+    }
+
+    for (int i = 0; i < page->count; i++) {
+        if (page->taken[i]) continue;
+        Vector2 p = page->pos[i];
+        if (p.x < vx0 || p.x > vx1 || p.y < vy0 || p.y > vy1) { stats->nodesCulled++; continue; }
+
+        Rectangle dst = (Rectangle){ p.x, p.y, w, h };
+        Assets_DrawSprite(spr, dst, origin, 0.0f, tint);
+        stats->nodesVisible++;
+    }
+}
+
+static RenderTexture2D SlotPage(const World* w, int slot) { return w->bakePage[slot / (BAKE_PAGE_SLOTS * BAKE_PAGE_SLOTS)]; }
+
+// slot area on its page, in render (top-left origin) coordinates
+static Rectangle SlotRect(int slot) {
+    int i = slot % (BAKE_PAGE_SLOTS * BAKE_PAGE_SLOTS);
+    return (Rectangle){ (i % BAKE_PAGE_SLOTS) * CHUNK_SIZE, (i / BAKE_PAGE_SLOTS) * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE };
+}
+
+static bool ChunkCached(const World* w, const Chunk* c) {
+    return c->bake >= 0 && !c->dirty && SlotPage(w, c->bake).id != 0;
+}
+
+// free slot first, else the least recently drawn one that isn't on screen now
+static int AcquireBakeSlot(World* w) {
+    int best = -1;
+    for (int i = 0; i < BAKE_POOL; i++) {
+        if (w->bakeOwner[i] < 0) return i;
+        if (w->bakeUsed[i] == w->frame) continue;
+        if (best < 0 || w->bakeUsed[i] < w->bakeUsed[best]) best = i;
+    }
+    if (best >= 0) w->chunks[w->bakeOwner[best]].bake = -1;
+    return best;
+}
+
+static void BakeChunk(const World* w, const NodeStore* nodes, struct Assets* assets, const Chunk* c, int slot) {
+    Rectangle r = ChunkRect(c);
+    Rectangle s = SlotRect(slot);
+    RenderStats scratch = { 0 };
+    PROF_ZONE(zone, "BakeChunk");
+
+    // ground tiles are opaque and cover the slot, so no clear; the scissor keeps
+    // overhanging sprites out of the neighbouring slots
+    Assets_BeginTextureMode(SlotPage(w, slot));
+    Assets_BeginScissorMode((int)s.x, (int)s.y, (int)s.width, (int)s.height);
+    Assets_BeginMode2D((Camera2D) { .offset = { s.x, s.y }, .target = { r.x, r.y }, .rotation = 0.0f, .zoom = 1.0f });
+
+    DrawGroundTiles(assets, c);
+    for (int k = 0; k < STATIC_TYPE_COUNT; k++) {
+        NodeType type = kStaticTypes[k];
+        Sprite spr = NodeImage(assets, type);
+        for (int ny = c->cy - 1; ny <= c->cy + 1; ny++) {
+            for (int nx = c->cx - 1; nx <= c->cx + 1; nx++) {
+                const Chunk* n = FindChunk(w, nx, ny);
+                if (n && n->page[type] >= 0) DrawPageNodes(nodes->pages[n->page[type]], spr, type, WHITE, r, &scratch);
             }
-            break;
+        }
+    }
+
+    Assets_EndMode2D();
+    Assets_EndScissorMode();
+    Assets_EndTextureMode();
+    PROF_END(zone);
+}
 
-        default:
-            break;
+void World_PrepareDraw(World* w, const NodeStore* nodes, struct Assets* assets, Rectangle view, RenderStats* stats) {
+    PROF_ZONE(zone, "World_PrepareDraw");
+    w->frame++;
+    for (int i = 0; i < w->chunkCount; i++) {
+        Chunk* c = &w->chunks[i];
+        if (!CheckCollisionRecs(ChunkRect(c), view)) continue;
+
+        if (c->bake >= 0) w->bakeUsed[c->bake] = w->frame;
+        if (ChunkCached(w, c) || stats->chunksBaked >= BAKES_PER_FRAME) continue;
+
+        int slot = (c->bake >= 0) ? c->bake : AcquireBakeSlot(w);
+        if (slot < 0) continue;   // pool full of on-screen chunks: draw this one live
+
+        RenderTexture2D* page = &w->bakePage[slot / (BAKE_PAGE_SLOTS * BAKE_PAGE_SLOTS)];
+        if (page->id == 0) {
+            *page = LoadRenderTexture((int)(BAKE_PAGE_SLOTS * CHUNK_SIZE), (int)(BAKE_PAGE_SLOTS * CHUNK_SIZE));
+            if (page->id == 0) continue;
+            SetTextureFilter(page->texture, TEXTURE_FILTER_POINT);
         }
+
+        w->bakeOwner[slot] = i;
+        w->bakeUsed[slot] = w->frame;
+        c->bake = slot;
+        BakeChunk(w, nodes, assets, c, slot);
+        c->dirty = false;
+        stats->chunksBaked++;
+    }
+    PROF_END(zone);
+}
+
+void World_Draw(const World* w, const NodeStore* nodes, struct Assets* assets, Rectangle view, RenderStats* stats) {
+    PROF_ZONE(zone, "World_Draw");
+    // 1) ground: one quad per cached chunk, tiles for the rest
+    for (int i = 0; i < w->chunkCount; i++) {
+        const Chunk* c = &w->chunks[i];
+        Rectangle r = ChunkRect(c);
+        if (!CheckCollisionRecs(r, view)) continue;
+
+        if (ChunkCached(w, c)) {
+            // render textures are stored bottom-up: flip the slot's rows
+            Texture2D tex = SlotPage(w, c->bake).texture;
+            Rectangle s = SlotRect(c->bake);
+            Sprite baked = { tex, { s.x, tex.height - s.y - s.height, s.width, -s.height } };
+            Assets_DrawSprite(baked, r, (Vector2) { 0, 0 }, 0.0f, WHITE);
+            stats->chunksCached++;
+        }
+        else {
+            DrawGroundTiles(assets, c);
+            stats->chunksDirect++;
+        }
+    }
+
+    // 2) static nodes of chunks that aren't cached, one pass per type
+    for (int k = 0; k < STATIC_TYPE_COUNT; k++) {
+        NodeType type = kStaticTypes[k];
+        Sprite spr = NodeImage(assets, type);
+        for (int i = 0; i < w->chunkCount; i++) {
+            const Chunk* c = &w->chunks[i];
+            if (c->page[type] < 0 || ChunkCached(w, c)) continue;
+            DrawPageNodes(nodes->pages[c->page[type]], spr, type, WHITE, view, stats);
+        }
+    }
+
+    // 3) clues, live every frame
+    float pulse = (sinf((float)GetTime() * 4.0f) * 0.5f + 0.5f);
+    Color clueTint = (Color){ 255, 255, 255, (unsigned char)(190 + 55 * pulse) };
+    for (int pg = nodes->firstPage[NODE_CLUE]; pg >= 0; pg = nodes->pages[pg]->nextOfType) {
+        DrawPageNodes(nodes->pages[pg], assets->sprClue, NODE_CLUE, clueTint, view, stats);
     }
+    PROF_END(zone);
 }
@@ -3,16 +3,82 @@
 #include "raylib.h"
 #include "game.h"
 #include "assets.h"
+#include "worldgen.h"
+#include "thread.h"
 #pragma once
 
 struct Assets;
 
-#define WORLD_W 4000
-#define WORLD_H 3000
+// The world is unbounded and split into CHUNK_SIZE squares. Each chunk is
+// generated from (seed, cx, cy) alone (see worldgen.h), so a chunk can be
+// dropped when it leaves the camera ring and rebuilt identically when the
+// player returns. Chunks that come into view together are planned in parallel.
+// What the player took is remembered for the whole run -- clues as a bitmask,
+// other nodes as a set of (cx, cy, type, index) keys -- and left out when its
+// chunk is rebuilt.
+#define CHUNK_SIZE    512.0f
+#define CHUNK_BUDGET  96        // default resident chunk count
+#define CHUNK_MARGIN  1         // chunks kept loaded beyond the view on each side
+#define CHUNK_TILES   8         // ground tiles per chunk side
 
-void World_SpawnScatter(Node* out, int* count, int cap, int type, int num);
-void World_DrawGround(struct Assets* assets);
-void World_DrawNodes(Node* nodes, int nodeCount, struct Assets* assets);
+// Home region: where the run starts and the clues are hidden.
+#define HOME_W 4000
+#define HOME_H 3000
+#define MAX_CLUES 4
 
-#endif // WORLD_MODULE_H
+// hard limit so float positions stay precise far from the origin
+#define WORLD_LIMIT 1.0e6f
+
+// Static layers (ground, ponds, resting pickups) are baked per chunk at one
+// texel per world unit into slots of a few large render textures, and redrawn
+// as a single quad per chunk; quads sharing a page batch together.
+#define BAKE_PAGE_SLOTS  4    // slots per page side (4x4 chunks per page)
+#define BAKE_PAGES       3
+#define BAKE_POOL        (BAKE_PAGES * BAKE_PAGE_SLOTS * BAKE_PAGE_SLOTS)   // 48 chunks, 1 MB each
+#define BAKES_PER_FRAME  4    // re-bake at most this many chunks per frame
+
+typedef struct Chunk {
+    int      cx, cy;
+    int      page[NODE_TYPE_COUNT];   // node pages owned by this chunk, -1 if none
+    unsigned lastSeen;                // stream tick this chunk was last wanted
+    int      bake;                    // slot in the bake pool, -1 if not cached
+    bool     dirty;                   // cached texture is stale
+    Color    ground[CHUNK_TILES * CHUNK_TILES];   // grass tint per tile, from the biome
+} Chunk;
+
+typedef struct World {
+    unsigned seed;
+    Chunk*   chunks;                  // resident set, budget entries
+    int      chunkCount;
+    int      budget;
+    unsigned tick;
+    Vector2  clues[MAX_CLUES];        // fixed clue spots inside the home region
+    unsigned cluesTaken;              // bit per clue
+    unsigned long long* taken;        // open-addressed set of taken node keys, 0 = empty slot
+    int      takenCount, takenCap;
+    GenWorld gen;
+    WorkerPool* workers;              // helps plan chunks; NULL plans on the caller
+    ChunkPlan*  plans;                // scratch for one stream call, budget entries
+
+    // static layer cache
+    RenderTexture2D bakePage[BAKE_PAGES]; // created lazily (needs a GL context)
+    int      bakeOwner[BAKE_POOL];        // index into chunks, -1 if free
+    unsigned bakeUsed[BAKE_POOL];         // frame the slot was last drawn
+    unsigned frame;
+} World;
 
+World* World_Create(unsigned seed, int budget, WorkerPool* workers);
+void   World_Destroy(World* w, NodeStore* nodes);
+void   World_Stream(World* w, NodeStore* nodes, Rectangle view);   // load the ring around view, evict beyond budget
+bool   World_IsLoaded(const World* w, Vector2 pos);
+void   World_OnTaken(World* w, const NodeStore* nodes, NodeId id);  // call before Nodes_Take
+
+// Taken-node keys, for snapshots. Restore before the first World_Stream.
+int    World_CopyTaken(const World* w, unsigned long long* out);   // returns the count; out may be NULL
+void   World_RestoreTaken(World* w, const unsigned long long* keys, int count);
+
+// World_PrepareDraw re-bakes stale visible chunks; call it outside BeginMode2D.
+void World_PrepareDraw(World* w, const NodeStore* nodes, struct Assets* assets, Rectangle view, RenderStats* stats);
+void World_Draw(const World* w, const NodeStore* nodes, struct Assets* assets, Rectangle view, RenderStats* stats);
+
+#endif // WORLD_MODULE_H
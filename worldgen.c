@@ -0,0 +1,342 @@
+#include "worldgen.h"
+#include "world.h"
+#include "profile.h"
+#include "raymath.h"
+#include <math.h>
+#include <string.h>
+
+// Same SIMD selection as the rival pool; WORLDGEN_SCALAR forces the plain
+// loop. A biome region always starts on a chunk edge and is a whole number
+// of vectors wide, so any one sample is computed by the same lane of the same
+// path whichever chunk's plan asks for it, and overlapping regions agree.
+#if !defined(WORLDGEN_SCALAR) && defined(__AVX__)
+#define WORLDGEN_AVX 1
+#include <immintrin.h>
+#elif !defined(WORLDGEN_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define WORLDGEN_SSE 1
+#include <emmintrin.h>
+#endif
+
+#define REGION      (3 * GEN_GRID)    // biome samples per side of a chunk and its neighbours
+#define CAND_MAX    8                 // candidates of one type in one chunk
+
+// -----------------------------------------------------------------------------
+// Counter-based randomness
+static unsigned Mix(unsigned h) {
+    h ^= h >> 16; h *= 0x7feb352dU;
+    h ^= h >> 15; h *= 0x846ca68bU;
+    h ^= h >> 16;
+    return h;
+}
+
+unsigned Gen_ChunkKey(unsigned seed, int cx, int cy) {
+    return Mix(seed ^ Mix((unsigned)cx * 0x9E3779B1U) ^ Mix((unsigned)cy * 0x85EBCA77U + 1u));
+}
+
+unsigned Gen_Rand(unsigned key, unsigned stream, unsigned n) {
+    return Mix(Mix(key + stream * 0x9E3779B9U) ^ (n * 0x85EBCA77U + 0x27D4EB2FU));
+}
+
+float Gen_Unit(unsigned key, unsigned stream, unsigned n) {
+    return (Gen_Rand(key, stream, n) & 0xFFFFFF) / (float)0x1000000;
+}
+
+// -----------------------------------------------------------------------------
+// Biome noise: value noise, three octaves, on lattices whose spacing is a
+// multiple of the widest vector (8 lanes x GEN_STEP)
+enum { FIELD_MOISTURE, FIELD_FOREST, FIELD_COUNT };
+#define OCTAVES 3
+static const float kOctaveSpan[OCTAVES] = { 2048.0f, 1024.0f, 256.0f };
+static const float kOctaveAmp[OCTAVES]  = { 0.5f, 0.3f, 0.2f };
+
+static float Lattice(unsigned key, int ix, int iy) {
+    return (Gen_ChunkKey(key, ix, iy) & 0xFFFFFF) / (float)0xFFFFFF;
+}
+
+static float Smooth(float t) { return t * t * (3.0f - 2.0f * t); }
+
+// One octave along a row of n samples from x0, added into out. Each lattice
+// column is blended down to y once; inside a cell all lanes share the two
+// blended edges, so a vector needs no gathers.
+static void NoiseRow(unsigned key, float span, float amp, float x0, float y, int n, float* out) {
+    const float inv = 1.0f / span;
+    float fy = floorf(y * inv);
+    int   iy = (int)fy;
+    float sy = Smooth((y - fy * span) * inv);
+
+    int   ix0 = (int)floorf(x0 * inv);
+    int   cols = (int)floorf((x0 + (float)(n - 1) * GEN_STEP) * inv) - ix0 + 2;
+    float edge[REGION + 2];
+    for (int k = 0; k < cols; k++) {
+        float a = Lattice(key, ix0 + k, iy), b = Lattice(key, ix0 + k, iy + 1);
+        edge[k] = a + (b - a) * sy;
+    }
+
+    int i = 0;
+#if WORLDGEN_AVX
+    const __m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 step = _mm256_set1_ps((float)GEN_STEP), vinv = _mm256_set1_ps(inv), vamp = _mm256_set1_ps(amp);
+    const __m256 two = _mm256_set1_ps(2.0f), three = _mm256_set1_ps(3.0f);
+    for (; i + 8 <= n; i += 8) {
+        float xs = x0 + (float)i * GEN_STEP;
+        float fx = floorf(xs * inv);
+        int   k = (int)fx - ix0;
+        __m256 x = _mm256_add_ps(_mm256_set1_ps(x0), _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps((float)i), lane), step));
+        __m256 t = _mm256_mul_ps(_mm256_sub_ps(x, _mm256_set1_ps(fx * span)), vinv);
+        __m256 s = _mm256_mul_ps(_mm256_mul_ps(t, t), _mm256_sub_ps(three, _mm256_mul_ps(two, t)));
+        __m256 a = _mm256_set1_ps(edge[k]), b = _mm256_set1_ps(edge[k + 1]);
+        __m256 v = _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), s));
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(vamp, v)));
+    }
+#elif WORLDGEN_SSE
+    const __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 step = _mm_set1_ps((float)GEN_STEP), vinv = _mm_set1_ps(inv), vamp = _mm_set1_ps(amp);
+    const __m128 two = _mm_set1_ps(2.0f), three = _mm_set1_ps(3.0f);
+    for (; i + 4 <= n; i += 4) {
+        float xs = x0 + (float)i * GEN_STEP;
+        float fx = floorf(xs * inv);
+        int   k = (int)fx - ix0;
+        __m128 x = _mm_add_ps(_mm_set1_ps(x0), _mm_mul_ps(_mm_add_ps(_mm_set1_ps((float)i), lane), step));
+        __m128 t = _mm_mul_ps(_mm_sub_ps(x, _mm_set1_ps(fx * span)), vinv);
+        __m128 s = _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(three, _mm_mul_ps(two, t)));
+        __m128 a = _mm_set1_ps(edge[k]), b = _mm_set1_ps(edge[k + 1]);
+        __m128 v = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), s));
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(vamp, v)));
+    }
+#endif
+    for (; i < n; i++) {
+        float x = x0 + (float)i * GEN_STEP;
+        float fx = floorf(x * inv);
+        int   k = (int)fx - ix0;
+        float t = (x - fx * span) * inv;
+        float s = t * t * (3.0f - 2.0f * t);
+        out[i] += amp * (edge[k] + (edge[k + 1] - edge[k]) * s);
+    }
+}
+
+// Both fields over a chunk and its eight neighbours, REGION x REGION samples
+// from the top-left corner of chunk (cx - 1, cy - 1).
+static void BiomeRegion(unsigned seed, int cx, int cy, float* field[FIELD_COUNT]) {
+    float x0 = (cx - 1) * CHUNK_SIZE, y0 = (cy - 1) * CHUNK_SIZE;
+    for (int f = 0; f < FIELD_COUNT; f++) {
+        memset(field[f], 0, REGION * REGION * sizeof(float));
+        for (int o = 0; o < OCTAVES; o++) {
+            unsigned key = Mix(seed ^ Mix(0xB105F00Du + (unsigned)(f * OCTAVES + o)));
+            for (int j = 0; j < REGION; j++) {
+                NoiseRow(key, kOctaveSpan[o], kOctaveAmp[o], x0, y0 + (float)j * GEN_STEP, REGION, field[f] + j * REGION);
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Resources
+// expected count per chunk, matching the old 4000x3000 map (22 berries, 18 sticks, 6 ponds)
+static const float kPerChunk[NODE_TYPE_COUNT] = {
+    [NODE_BERRY] = 22.0f * (CHUNK_SIZE * CHUNK_SIZE) / (HOME_W * HOME_H),
+    [NODE_STICK] = 18.0f * (CHUNK_SIZE * CHUNK_SIZE) / (HOME_W * HOME_H),
+    [NODE_POND]  =  6.0f * (CHUNK_SIZE * CHUNK_SIZE) / (HOME_W * HOME_H),
+    [NODE_CLUE]  = 0.0f,   // clues are placed explicitly
+};
+
+// Minimum distance between two nodes by type. Pickups look for ponds within
+// 90 whose own spacing reaches 200 further: 40 + 90 + 200 stays inside the
+// neighbouring chunks, so a chunk's plan never needs anything beyond them.
+static const float kSpacing[NODE_TYPE_COUNT][NODE_TYPE_COUNT] = {
+    [NODE_BERRY] = { [NODE_BERRY] = 40.0f,  [NODE_STICK] = 30.0f,  [NODE_POND] = 90.0f  },
+    [NODE_STICK] = { [NODE_BERRY] = 30.0f,  [NODE_STICK] = 40.0f,  [NODE_POND] = 90.0f  },
+    [NODE_POND]  = { [NODE_BERRY] = 90.0f,  [NODE_STICK] = 90.0f,  [NODE_POND] = 200.0f },
+};
+static const float kKeepOut[NODE_TYPE_COUNT] = { [NODE_BERRY] = 40.0f, [NODE_STICK] = 40.0f, [NODE_POND] = 120.0f };
+
+static float Ramp(float v, float lo, float hi) {
+    float t = (v - lo) / (hi - lo);
+    return t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+}
+
+// Local density relative to kPerChunk: ponds gather in wet ground, berries
+// in damp open meadows, sticks under trees. kPeak bounds it; kNorm brings
+// the average over many seeds back to 1 after thinning and spacing.
+static float Density(NodeType t, float m, float f) {
+    switch (t) {
+    case NODE_POND:  return 0.2f + 2.4f * Ramp(m, 0.45f, 0.65f);
+    case NODE_BERRY: return 0.3f + 1.8f * Ramp(m, 0.35f, 0.6f) * (1.0f - Ramp(f, 0.5f, 0.65f));
+    case NODE_STICK: return 0.2f + 2.2f * Ramp(f, 0.4f, 0.6f);
+    default:         return 0.0f;
+    }
+}
+static const float kPeak[NODE_TYPE_COUNT] = { [NODE_BERRY] = 2.1f, [NODE_STICK] = 2.4f, [NODE_POND] = 2.6f };
+static const float kNorm[NODE_TYPE_COUNT] = { [NODE_BERRY] = 1.01f, [NODE_STICK] = 0.79f, [NODE_POND] = 0.92f };
+
+static const NodeType kGenTypes[] = { NODE_POND, NODE_BERRY, NODE_STICK };
+#define GEN_TYPE_COUNT (int)(sizeof(kGenTypes) / sizeof(kGenTypes[0]))
+
+typedef struct Candidate {
+    Vector2  pos;
+    unsigned prio;
+    NodeType type;
+    bool     home;     // inside the chunk being planned
+    bool     live;     // survived thinning and the keep-outs (and, for pickups, the ponds)
+    bool     kept;
+} Candidate;
+
+// Higher priority wins; position breaks the (unlikely) ties
+static bool Outranks(const Candidate* a, const Candidate* b) {
+    if (a->prio != b->prio) return a->prio > b->prio;
+    if (a->pos.x != b->pos.x) return a->pos.x < b->pos.x;
+    return a->pos.y < b->pos.y;
+}
+
+static bool Crowds(const Candidate* a, const Candidate* b) {
+    float r = kSpacing[a->type][b->type];
+    float dx = a->pos.x - b->pos.x, dy = a->pos.y - b->pos.y;
+    return dx * dx + dy * dy < r * r;
+}
+
+// Live candidates of one chunk, from that chunk's own streams only. Biome
+// samples come from the region grid at the sample cell holding the candidate.
+static int ChunkCandidates(const GenWorld* gw, int cx, int cy, int rx, int ry, float* field[FIELD_COUNT], Candidate* out) {
+    unsigned key = Gen_ChunkKey(gw->seed, cx, cy);
+    int n = 0;
+    for (int k = 0; k < GEN_TYPE_COUNT; k++) {
+        NodeType t = kGenTypes[k];
+        int count = (int)(kPerChunk[t] * kPeak[t] * kNorm[t] + Gen_Unit(key, t, 0));
+        if (count > CAND_MAX) count = CAND_MAX;
+        for (int i = 0; i < count; i++) {
+            float lx = Gen_Unit(key, t, 1 + 4 * i) * CHUNK_SIZE, ly = Gen_Unit(key, t, 2 + 4 * i) * CHUNK_SIZE;
+            int   s = (ry * GEN_GRID + (int)(ly / GEN_STEP)) * REGION + rx * GEN_GRID + (int)(lx / GEN_STEP);
+            if (Gen_Unit(key, t, 3 + 4 * i) * kPeak[t] >= Density(t, field[FIELD_MOISTURE][s], field[FIELD_FOREST][s])) continue;
+
+            Candidate* c = &out[n];
+            c->pos = (Vector2){ cx * CHUNK_SIZE + lx, cy * CHUNK_SIZE + ly };
+            c->prio = Gen_Rand(key, t, 4 + 4 * i);
+            c->type = t;
+            c->home = (rx == 1 && ry == 1);
+            c->live = true;
+            c->kept = false;
+            for (int j = 0; j < gw->keepOutCount; j++) {
+                float dx = c->pos.x - gw->keepOut[j].x, dy = c->pos.y - gw->keepOut[j].y;
+                if (dx * dx + dy * dy < kKeepOut[t] * kKeepOut[t]) c->live = false;
+            }
+            if (c->live) n++;
+        }
+    }
+    return n;
+}
+
+void Gen_PlanChunk(const GenWorld* gw, ChunkPlan* plan) {
+    PROF_ZONE(zone, "Gen_PlanChunk");
+    float  moisture[REGION * REGION], forest[REGION * REGION];
+    float* field[FIELD_COUNT] = { moisture, forest };
+    BiomeRegion(gw->seed, plan->cx, plan->cy, field);
+
+    Candidate cand[9 * GEN_TYPE_COUNT * CAND_MAX];
+    int n = 0;
+    for (int ry = 0; ry < 3; ry++) {
+        for (int rx = 0; rx < 3; rx++) n += ChunkCandidates(gw, plan->cx + rx - 1, plan->cy + ry - 1, rx, ry, field, cand + n);
+    }
+
+    // ponds first: one stays unless a higher-ranked pond is too close
+    for (int i = 0; i < n; i++) {
+        if (cand[i].type != NODE_POND) continue;
+        cand[i].kept = true;
+        for (int j = 0; j < n && cand[i].kept; j++) {
+            if (j != i && cand[j].type == NODE_POND && Crowds(&cand[i], &cand[j]) && Outranks(&cand[j], &cand[i])) cand[i].kept = false;
+        }
+    }
+    // pickups clear of kept ponds, then the same rule among themselves
+    for (int i = 0; i < n; i++) {
+        if (cand[i].type == NODE_POND) continue;
+        for (int j = 0; j < n && cand[i].live; j++) {
+            if (cand[j].kept && Crowds(&cand[i], &cand[j])) cand[i].live = false;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        if (cand[i].type == NODE_POND || !cand[i].live || !cand[i].home) continue;
+        cand[i].kept = true;
+        for (int j = 0; j < n && cand[i].kept; j++) {
+            if (j != i && cand[j].type != NODE_POND && cand[j].live && Crowds(&cand[i], &cand[j]) && Outranks(&cand[j], &cand[i])) cand[i].kept = false;
+        }
+    }
+
+    for (int t = 0; t < NODE_TYPE_COUNT; t++) plan->count[t] = 0;
+    for (int i = 0; i < n; i++) {
+        if (!cand[i].home || !cand[i].kept) continue;
+        NodeType t = cand[i].type;
+        if (plan->count[t] < GEN_PLAN_MAX) plan->pos[t][plan->count[t]++] = cand[i].pos;
+    }
+    for (int j = 0; j < GEN_GRID; j++) {
+        memcpy(plan->moisture + j * GEN_GRID, moisture + (GEN_GRID + j) * REGION + GEN_GRID, GEN_GRID * sizeof(float));
+        memcpy(plan->forest + j * GEN_GRID, forest + (GEN_GRID + j) * REGION + GEN_GRID, GEN_GRID * sizeof(float));
+    }
+    PROF_END(zone);
+}
+
+void Gen_PlaceClues(unsigned seed, Vector2* clues, int count, float w, float h) {
+    // spread out: a few tries per clue to land away from the others
+    unsigned key = Gen_ChunkKey(seed, 0x7fffffff, 0x7fffffff);
+    float minDist = 0.2f * (w < h ? w : h);
+    unsigned n = 0;
+    for (int i = 0; i < count; i++) {
+        for (int tries = 0; tries < 16; tries++) {
+            clues[i] = (Vector2){ 100.0f + Gen_Unit(key, 0, n) * (w - 200.0f), 100.0f + Gen_Unit(key, 0, n + 1) * (h - 200.0f) };
+            n += 2;
+            bool clear = true;
+            for (int j = 0; j < i; j++) {
+                if (Vector2Distance(clues[i], clues[j]) < minDist) clear = false;
+            }
+            if (clear) break;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Parallel planning. Helpers and the caller pull chunk indices from one
+// counter; the caller waits only for plans already claimed. The batch lives on
+// the heap until its last user lets go, since a helper still queued behind
+// other jobs may only start after the caller has moved on.
+typedef struct GenBatch {
+    GenWorld     gen;
+    ChunkPlan*   plans;
+    int          count;
+    volatile int next, done, refs;
+} GenBatch;
+
+static void RunBatch(GenBatch* b) {
+    for (;;) {
+        int i = Atomic_Add(&b->next, 1) - 1;
+        if (i >= b->count) return;
+        Gen_PlanChunk(&b->gen, &b->plans[i]);
+        Atomic_Add(&b->done, 1);
+    }
+}
+
+static void ReleaseBatch(GenBatch* b) {
+    if (Atomic_Add(&b->refs, -1) == 0) MemFree(b);
+}
+
+static void PlanJob(void* arg) {
+    GenBatch* b = arg;
+    RunBatch(b);
+    ReleaseBatch(b);
+}
+
+void Gen_PlanChunks(const GenWorld* gw, ChunkPlan* plans, int count, WorkerPool* pool) {
+    if (count <= 0) return;
+    int helpers = WorkerPool_Threads(pool);
+    if (helpers > count - 1) helpers = count - 1;
+    if (helpers == 0) {
+        for (int i = 0; i < count; i++) Gen_PlanChunk(gw, &plans[i]);
+        return;
+    }
+
+    GenBatch* b = MemAlloc(sizeof(GenBatch));
+    b->gen = *gw;
+    b->plans = plans;
+    b->count = count;
+    b->refs = 1 + helpers;
+    for (int i = 0; i < helpers; i++) WorkerPool_Submit(pool, PlanJob, b);
+    RunBatch(b);
+    while (Atomic_Load(&b->done) < count) Thread_Sleep(0);
+    ReleaseBatch(b);
+}
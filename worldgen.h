@@ -0,0 +1,50 @@
+#ifndef WORLDGEN_H
+#define WORLDGEN_H
+#include "raylib.h"
+#include "nodes.h"
+#include "thread.h"
+#pragma once
+
+// Chunk contents as a pure function of (seed, cx, cy). Randomness comes from
+// counter-based streams -- the n-th number of a stream is a hash of (chunk,
+// stream, n) with no state carried between calls -- so chunks can be planned
+// in any order, on any thread, and always come out the same. Two biome fields
+// (moisture and forest) are value noise sampled on a GEN_STEP grid by a SIMD
+// row kernel; they thin each resource's candidates to a local density. The
+// survivors are spaced Poisson-disc style: a candidate stays only if it
+// outranks (by a hashed priority) every candidate it would crowd, which needs
+// nothing beyond the neighbouring chunks and so never depends on what was
+// generated first.
+#define GEN_STEP        32        // world units per biome sample
+#define GEN_GRID        16        // biome samples per chunk side (CHUNK_SIZE / GEN_STEP)
+#define GEN_PLAN_MAX    32        // nodes of one type in one chunk
+#define GEN_KEEPOUT_MAX 8
+
+typedef struct GenWorld {
+    unsigned seed;
+    Vector2  keepOut[GEN_KEEPOUT_MAX];    // spots nothing else may crowd: clues, the spawn
+    int      keepOutCount;
+} GenWorld;
+
+typedef struct ChunkPlan {
+    int     cx, cy;                        // set by the caller
+    int     count[NODE_TYPE_COUNT];
+    Vector2 pos[NODE_TYPE_COUNT][GEN_PLAN_MAX];
+    float   moisture[GEN_GRID * GEN_GRID]; // 0..1, row-major from the chunk's top-left sample
+    float   forest[GEN_GRID * GEN_GRID];
+} ChunkPlan;
+
+unsigned Gen_ChunkKey(unsigned seed, int cx, int cy);
+unsigned Gen_Rand(unsigned key, unsigned stream, unsigned n);   // n-th number of a chunk's stream
+float    Gen_Unit(unsigned key, unsigned stream, unsigned n);   // the same, in [0, 1)
+
+// Clue spots in the home region, from the seed alone.
+void Gen_PlaceClues(unsigned seed, Vector2* clues, int count, float w, float h);
+
+// One chunk, on the calling thread.
+void Gen_PlanChunk(const GenWorld* gw, ChunkPlan* plan);
+// Many chunks, shared between the calling thread and the pool (NULL: inline).
+// Returns once every plan is filled; the result never depends on the pool.
+void Gen_PlanChunks(const GenWorld* gw, ChunkPlan* plans, int count, WorkerPool* pool);
+
+#endif